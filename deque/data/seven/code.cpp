@@ -0,0 +1,49 @@
+#include <iostream>
+#include <string>
+#include "deque.hpp"
+
+typedef sjtu::deque<std::string, sjtu::counting_allocator<std::string> > counted;
+
+void test_default()
+{
+	std::cout << "Testing the default allocator..." << std::endl;
+	sjtu::deque<int> q;
+	for (int i = 0; i < 5000; ++i) {
+		if (i & 1) q.push_back(i);
+		else q.push_front(i);
+	}
+	std::cout << q.size() << " " << q.front() << " " << q.back() << " " << q[2500] << std::endl;
+	std::cout << (q.get_allocator() == sjtu::allocator<int>()) << std::endl;
+}
+
+void test_counting()
+{
+	std::cout << "Testing counting allocator..." << std::endl;
+	sjtu::allocation_stats stats;
+	{
+		counted q{sjtu::counting_allocator<std::string>(stats)};
+		size_t empty = stats.live();
+		for (int i = 0; i < 3000; ++i) {
+			q.push_back(std::to_string(i));
+		}
+		// one block per element plus the nodes and their pointer arrays
+		std::cout << empty << " " << (stats.live() > 3000) << std::endl;
+		counted copy(q);
+		std::cout << (copy.get_allocator() == q.get_allocator()) << " " << copy[1234] << std::endl;
+		for (int i = 0; i < 1000; ++i) {
+			q.pop_front();
+		}
+		std::cout << q.size() << " " << q.front() << std::endl;
+		q.clear();
+		copy = q;
+		std::cout << copy.size() << " " << stats.live() << std::endl;
+	}
+	std::cout << stats.live() << " " << stats.bytes << " " << (stats.allocations > 6000) << std::endl;
+}
+
+int main()
+{
+	test_default();
+	test_counting();
+	return 0;
+}
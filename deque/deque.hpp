@@ -2,27 +2,42 @@
 #define SJTU_DEQUE_HPP
 
 #include "exceptions.hpp"
+#include "allocator.hpp"
 
 #include <cstddef>
+#include <memory>
+#include <new>
 
 namespace sjtu
 {
     const int SIZE = 512;
 
-    template<class T>
+    /**
+     * elements, the per-node pointer arrays and the nodes themselves all
+     * come from Alloc, rebound as needed; see allocator.hpp.
+     */
+    template<class T, class Alloc = allocator<T>>
     class deque
     {
+    public:
+        typedef Alloc allocator_type;
+
     private:
+        typedef std::allocator_traits<Alloc> traits;
+        typedef typename traits::template rebind_alloc<T *> slot_allocator;
+        typedef std::allocator_traits<slot_allocator> slot_traits;
+
         struct node
         {
             T **data;
             size_t size;
             node *pre;
             node *nxt;
+            Alloc alloc;
 
-            node() : size(0), pre(nullptr), nxt(nullptr)
+            explicit node(const Alloc &a) : size(0), pre(nullptr), nxt(nullptr), alloc(a)
             {
-                data = new T *[SIZE + 1];
+                data = allocateSlots();
             }
 
             ~node()
@@ -30,25 +45,48 @@ namespace sjtu
                 clear();
             }
 
-            node(const node &o)
+            node(const node &o, const Alloc &a) : size(0), pre(nullptr), nxt(nullptr), alloc(a)
             {
-                size = o.size;
-                data = new T *[SIZE + 1];
-                for (size_t i = 0; i < size; ++i)
-                    data[i] = new T(*o.data[i]);
+                data = allocateSlots();
+                try
+                {
+                    for (; size < o.size; ++size)
+                        data[size] = create(*o.data[size]);
+                } catch (...)
+                {
+                    clear();
+                    throw;
+                }
             }
 
-            node &operator=(const node &o)
+            node(const node &o) = delete;
+
+            node &operator=(const node &o) = delete;
+
+            T **allocateSlots()
             {
-                if (this == &o) return *this;
+                slot_allocator a(alloc);
+                return slot_traits::allocate(a, SIZE + 1);
+            }
 
-                clear();
+            T *create(const T &x)
+            {
+                T *p = traits::allocate(alloc, 1);
+                try
+                {
+                    new(p) T(x);
+                } catch (...)
+                {
+                    traits::deallocate(alloc, p, 1);
+                    throw;
+                }
+                return p;
+            }
 
-                size = o.size;
-                data = new T *[SIZE + 1];
-                for (size_t i = 0; i < size; ++i)
-                    data[i] = new T(*o.data[i]);
-                return *this;
+            void dispose(T *p)
+            {
+                p->~T();
+                traits::deallocate(alloc, p, 1);
             }
 
             T &operator[](const int pos) const
@@ -60,16 +98,17 @@ namespace sjtu
             void insert(const int pos, const T &x)
             {
                 if (pos < 0 || pos > size) throw index_out_of_bound();
+                T *p = create(x);
                 for (int i = size; i > pos; --i)
                     data[i] = data[i - 1];
-                data[pos] = new T(x);
+                data[pos] = p;
                 size++;
             }
 
             void erase(int pos)
             {
                 if (pos < 0 || pos >= size) throw index_out_of_bound();
-                delete data[pos];
+                dispose(data[pos]);
                 for (int i = pos; i < size - 1; ++i)
                     data[i] = data[i + 1];
                 size--;
@@ -78,22 +117,64 @@ namespace sjtu
             void clear()
             {
                 for (size_t i = 0; i < size; ++i)
-                    delete data[i];
-                delete[]data;
+                    dispose(data[i]);
+                slot_allocator a(alloc);
+                slot_traits::deallocate(a, data, SIZE + 1);
                 size = 0;
             }
         };
 
+        typedef typename traits::template rebind_alloc<node> node_allocator;
+        typedef std::allocator_traits<node_allocator> node_traits;
+
         size_t len;
         node *head;
         node *tail;
+        Alloc alloc;
+
+        node *newNode()
+        {
+            node_allocator a(alloc);
+            node *p = node_traits::allocate(a, 1);
+            try
+            {
+                new(p) node(alloc);
+            } catch (...)
+            {
+                node_traits::deallocate(a, p, 1);
+                throw;
+            }
+            return p;
+        }
+
+        node *newNode(const node &o)
+        {
+            node_allocator a(alloc);
+            node *p = node_traits::allocate(a, 1);
+            try
+            {
+                new(p) node(o, alloc);
+            } catch (...)
+            {
+                node_traits::deallocate(a, p, 1);
+                throw;
+            }
+            return p;
+        }
+
+        void deleteNode(node *p)
+        {
+            node_allocator a(alloc);
+            p->~node();
+            node_traits::deallocate(a, p, 1);
+        }
 
     public:
         class const_iterator;
 
         class iterator
         {
-            friend class deque<T>;
+            friend class deque;
 
         private:
             deque *dq;
@@ -303,7 +384,7 @@ namespace sjtu
         {
             // it should has similar member method as iterator.
             //  and it should be able to construct from an iterator.
-            friend class deque<T>;
+            friend class deque;
 
         private:
             const deque *dq;
@@ -524,23 +605,35 @@ namespace sjtu
          * TODO Constructors
          */
         deque()
+        {
+            init();
+        }
+
+        explicit deque(const Alloc &a) : alloc(a)
+        {
+            init();
+        }
+
+    private:
+        void init()
         {
             len = 0;
-            head = new node;
-            tail = new node;
+            head = newNode();
+            tail = newNode();
             head->nxt = tail;
             tail->pre = head;
         }
 
-        deque(const deque &other)
+    public:
+        deque(const deque &other) : alloc(traits::select_on_container_copy_construction(other.alloc))
         {
             len = other.len;
-            head = new node(*(other.head));
-            tail = new node();
+            head = newNode(*(other.head));
+            tail = newNode();
             node *p = head, *q = other.head->nxt;
             while (q != other.tail)
             {
-                p->nxt = new node(*q);
+                p->nxt = newNode(*q);
                 (p->nxt)->pre = p;
                 p = p->nxt;
                 q = q->nxt;
@@ -555,8 +648,8 @@ namespace sjtu
         ~deque()
         {
             clear();
-            delete head;
-            delete tail;
+            deleteNode(head);
+            deleteNode(tail);
         }
 
         /**
@@ -569,14 +662,14 @@ namespace sjtu
             clear();
 
             len = other.len;
-            delete head;
-            delete tail;
-            head = new node(*(other.head));
-            tail = new node();
+            deleteNode(head);
+            deleteNode(tail);
+            head = newNode(*(other.head));
+            tail = newNode();
             node *p = head, *q = other.head->nxt;
             while (q != other.tail)
             {
-                p->nxt = new node(*q);
+                p->nxt = newNode(*q);
                 (p->nxt)->pre = p;
                 p = p->nxt;
                 q = q->nxt;
@@ -706,6 +799,11 @@ namespace sjtu
             return len;
         }
 
+        Alloc get_allocator() const
+        {
+            return alloc;
+        }
+
         /**
          * clears the contents
          */
@@ -715,12 +813,12 @@ namespace sjtu
             while (q->nxt != nullptr)
             {
                 p = q->nxt;
-                delete q;
+                deleteNode(q);
                 q = p;
             }
             len = 0;
-            delete head;
-            head = new node;
+            deleteNode(head);
+            head = newNode();
             head->nxt = tail;
             tail->pre = head;
         }
@@ -734,7 +832,7 @@ namespace sjtu
                 {
                     node *p = n;
                     n = n->nxt;
-                    delete p;
+                    deleteNode(p);
                 }
                 node *p = n->nxt;
                 for (int i = n->size; i < n->size + p->size; ++i)
@@ -743,7 +841,7 @@ namespace sjtu
                 p->size = 0;
                 n->nxt = p->nxt;
                 n->nxt->pre = n;
-                delete p;
+                deleteNode(p);
             }
             if (n->nxt != tail && n->size < SIZE / 2)
             {
@@ -759,7 +857,7 @@ namespace sjtu
                 {
                     n->nxt = p->nxt;
                     n->nxt->pre = n;
-                    delete p;
+                    deleteNode(p);
                 } else
                 {
                     for (int i = 0; i < tmp2; ++i)
@@ -772,7 +870,7 @@ namespace sjtu
         void split(node *n)
         {
             if (n == tail || n->size < SIZE) return;
-            node *tmp = new node;
+            node *tmp = newNode();
             (n->nxt)->pre = tmp;
             tmp->nxt = n->nxt;
             tmp->pre = n;
@@ -0,0 +1,140 @@
+#ifndef SJTU_HUGE_PAGES_HPP
+#define SJTU_HUGE_PAGES_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+/**
+ * build flags:
+ *   SJTU_HUGE_PAGES            buffers of at least SJTU_HUGE_PAGE_THRESHOLD bytes are
+ *                              mmap'ed on a 2MB boundary and advised with MADV_HUGEPAGE.
+ *   SJTU_HUGE_PAGE_THRESHOLD   the size in bytes, 32MB by default.
+ *   SJTU_PREFAULT              such buffers are also faulted in up front, so the first
+ *                              pass over them takes no page faults.
+ * without SJTU_HUGE_PAGES every buffer comes from operator new.
+ */
+#ifndef SJTU_HUGE_PAGE_THRESHOLD
+#define SJTU_HUGE_PAGE_THRESHOLD (size_t(32)<<20)
+#endif
+
+#ifdef SJTU_HUGE_PAGES
+#include <sys/mman.h>
+#endif
+
+namespace sjtu
+{
+    struct huge_pages
+    {
+        static const size_t HUGE_PAGE=size_t(2)<<20;
+
+        /**
+         * whether a buffer of this many bytes takes the mmap path.
+         * it only depends on build flags, so allocate and deallocate always agree.
+         */
+        static bool eligible(size_t bytes)
+        {
+#ifdef SJTU_HUGE_PAGES
+            return bytes>=SJTU_HUGE_PAGE_THRESHOLD;
+#else
+            (void)bytes;
+            return false;
+#endif
+        }
+
+        /**
+         * bytes currently in buffers the kernel accepted MADV_HUGEPAGE for.
+         * whether they are actually backed by huge pages is up to the kernel,
+         * see AnonHugePages in /proc/self/smaps.
+         */
+        static size_t bytes()
+        {
+            return counter().load();
+        }
+
+        static void *allocate(size_t bytes)
+        {
+#ifdef SJTU_HUGE_PAGES
+            if(!eligible(bytes)) return ::operator new(bytes);
+            size_t length=roundUp(bytes);
+            //over-map by one huge page and trim, so the buffer starts on a 2MB boundary
+            void *p=mmap(nullptr, length+HUGE_PAGE, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+            if(p==MAP_FAILED) throw std::bad_alloc();
+            char *raw=static_cast<char *>(p);
+            char *start=raw+(HUGE_PAGE-reinterpret_cast<size_t>(raw)%HUGE_PAGE)%HUGE_PAGE;
+            if(start!=raw) munmap(raw, start-raw);
+            if(start+length!=raw+length+HUGE_PAGE) munmap(start+length, raw+HUGE_PAGE-start);
+            if(supported()&&madvise(start, length, MADV_HUGEPAGE)==0) counter().fetch_add(length);
+#ifdef SJTU_PREFAULT
+            prefault(start, length);
+#endif
+            return start;
+#else
+            return ::operator new(bytes);
+#endif
+        }
+
+        static void deallocate(void *p, size_t bytes)
+        {
+            if(p==nullptr) return;
+            if(!eligible(bytes))
+            {
+                ::operator delete(p);
+                return;
+            }
+#ifdef SJTU_HUGE_PAGES
+            size_t length=roundUp(bytes);
+            munmap(p, length);
+            if(supported()) counter().fetch_sub(length);
+#endif
+        }
+
+    private:
+        static std::atomic<size_t> &counter()
+        {
+            static std::atomic<size_t> advised(0);
+            return advised;
+        }
+
+        static size_t roundUp(size_t bytes)
+        {
+            return (bytes+HUGE_PAGE-1)/HUGE_PAGE*HUGE_PAGE;
+        }
+
+#ifdef SJTU_HUGE_PAGES
+        /**
+         * whether this kernel takes MADV_HUGEPAGE at all, probed once so that
+         * the counter is updated the same way on allocation and release.
+         */
+        static bool supported()
+        {
+            static const bool ok=probe();
+            return ok;
+        }
+
+        static bool probe()
+        {
+            void *p=mmap(nullptr, HUGE_PAGE, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+            if(p==MAP_FAILED) return false;
+            bool ok=madvise(p, HUGE_PAGE, MADV_HUGEPAGE)==0;
+            munmap(p, HUGE_PAGE);
+            return ok;
+        }
+
+        /**
+         * fault the buffer in after madvise, so the faults can use huge pages
+         * (MAP_POPULATE would fault in small pages before the advice applies).
+         */
+        static void prefault(char *start, size_t length)
+        {
+#ifdef MADV_POPULATE_WRITE
+            if(madvise(start, length, MADV_POPULATE_WRITE)==0) return;
+#endif
+            for(size_t i=0;i<length;i+=4096)
+                static_cast<volatile char *>(start)[i]=0;
+        }
+#endif
+    };
+}
+
+#endif
@@ -0,0 +1,44 @@
+#include "map.hpp"
+#include <iostream>
+#include <string>
+
+typedef sjtu::map<int, std::string, std::less<int>, sjtu::counting_allocator<sjtu::pair<const int, std::string> > > counted;
+
+void tester_default(void) {
+	std::cout << "Testing the default allocator..." << std::endl;
+	sjtu::map<int, int> map;
+	for (int i = 0; i < 10000; ++i) {
+		map[i * 7 % 10000] = i;
+	}
+	std::cout << map.size() << " " << map[49] << " " << (map.get_allocator() == sjtu::allocator<sjtu::pair<const int, int> >()) << std::endl;
+}
+
+void tester_counting(void) {
+	std::cout << "Testing counting allocator..." << std::endl;
+	sjtu::allocation_stats stats;
+	{
+		counted map{sjtu::counting_allocator<sjtu::pair<const int, std::string> >(stats)};
+		for (int i = 0; i < 1000; ++i) {
+			map[i] = std::to_string(i);
+		}
+		// one node per element
+		std::cout << stats.allocations << " " << stats.live() << std::endl;
+		counted copy(map);
+		std::cout << stats.live() << " " << copy.at(500) << " " << (copy.get_allocator() == map.get_allocator()) << std::endl;
+		for (int i = 0; i < 1000; i += 2) {
+			map.erase(map.find(i));
+		}
+		std::cout << map.size() << " " << stats.live() << std::endl;
+		copy = map;
+		std::cout << copy.size() << " " << stats.live() << std::endl;
+		map.clear();
+		std::cout << stats.live() << std::endl;
+	}
+	std::cout << stats.live() << " " << stats.bytes << std::endl;
+}
+
+int main(void) {
+	tester_default();
+	tester_counting();
+	return 0;
+}
@@ -0,0 +1,276 @@
+#include "flat_map.hpp"
+#include "map.hpp"
+#include <iostream>
+#include <cassert>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+class Integer {
+public:
+	static int counter;
+	int val;
+
+	Integer(int val) : val(val) {
+		counter++;
+	}
+
+	Integer(const Integer &rhs) {
+		val = rhs.val;
+		counter++;
+	}
+
+	Integer& operator = (const Integer &) {
+		assert(false);
+		return *this;
+	}
+
+	~Integer() {
+		counter--;
+	}
+};
+
+int Integer::counter = 0;
+
+class Compare {
+public:
+	bool operator () (const Integer &lhs, const Integer &rhs) const {
+		return lhs.val < rhs.val;
+	}
+};
+
+void tester_api(void) {
+	sjtu::flat_map<Integer, std::string, Compare> map;
+	std::cout << map.empty() << " " << map.size() << std::endl;
+	for (int i = 0; i < 100; ++i) {
+		map[Integer(i * 7 % 100)] = std::to_string(i);
+	}
+	auto result = map.insert(sjtu::pair<Integer, std::string>(Integer(3), "three"));
+	std::cout << result.second << " " << result.first->second << std::endl;
+	auto big = map.insert(sjtu::pair<Integer, std::string>(Integer(1000), "big"));
+	std::cout << big.second << " " << (*big.first).first.val << " " << map.size() << std::endl;
+	std::cout << map.at(Integer(49)) << " " << map.count(Integer(50)) << " " << map.count(Integer(500)) << std::endl;
+	try {
+		map.at(Integer(-1));
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	int prev = -1;
+	bool sorted = true;
+	for (sjtu::flat_map<Integer, std::string, Compare>::iterator it = map.begin(); it != map.end(); ++it) {
+		sorted = sorted && it->first.val > prev;
+		prev = it->first.val;
+	}
+	std::cout << sorted << std::endl;
+	map.erase(map.find(Integer(0)));
+	std::cout << map.begin()->first.val << " " << map.size() << std::endl;
+	try {
+		map.erase(map.end());
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		map.begin()--;
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	const sjtu::flat_map<Integer, std::string, Compare> copy(map);
+	sjtu::flat_map<Integer, std::string, Compare>::const_iterator cit = copy.find(Integer(1000));
+	std::cout << cit->second << " " << copy[Integer(10)] << " " << (--copy.cend())->first.val << std::endl;
+	map = copy;
+	map.clear();
+	std::cout << map.size() << " " << copy.size() << std::endl;
+}
+
+void tester_against_map(void) {
+	sjtu::flat_map<Integer, int, Compare> flat;
+	sjtu::map<Integer, int, Compare> tree;
+	unsigned seed = 2023;
+	for (int step = 0; step < 200000; ++step) {
+		seed = seed * 1103515245 + 12345;
+		int key = (seed >> 8) % 5000;
+		int op = (seed >> 4) % 4;
+		if (op == 0) {
+			flat[Integer(key)] += step;
+			tree[Integer(key)] += step;
+		} else if (op == 1) {
+			auto f = flat.find(Integer(key));
+			auto t = tree.find(Integer(key));
+			if ((f == flat.end()) != (t == tree.end())) {
+				std::cout << "find differs" << std::endl;
+			}
+			if (f != flat.end()) {
+				flat.erase(f);
+				tree.erase(t);
+			}
+		} else if (op == 2) {
+			flat.insert(sjtu::pair<Integer, int>(Integer(key), step));
+			tree.insert(sjtu::pair<Integer, int>(Integer(key), step));
+		} else if (flat.count(Integer(key)) != tree.count(Integer(key))) {
+			std::cout << "count differs" << std::endl;
+		}
+	}
+	bool same = flat.size() == tree.size();
+	auto t = tree.cbegin();
+	for (auto f = flat.cbegin(); same && f != flat.cend(); ++f, ++t) {
+		same = f->first.val == t->first.val && f->second == t->second;
+	}
+	std::cout << flat.size() << " " << same << std::endl;
+}
+
+void tester_batch(void) {
+	sjtu::flat_map<Integer, int, Compare> map;
+	for (int i = 0; i < 1000; i += 2) {
+		map[Integer(i)] = -i;
+	}
+	sjtu::pair<Integer, int> *batch = (sjtu::pair<Integer, int> *)::operator new(3000 * sizeof(sjtu::pair<Integer, int>));
+	for (int i = 0; i < 3000; ++i) {
+		// every key below 2000 appears once or twice, the earlier copy must win
+		new (batch + i) sjtu::pair<Integer, int>(Integer((i * 37) % 2000), i);
+	}
+	size_t inserted = map.insert_batch(batch, batch + 3000);
+	std::cout << inserted << " " << map.size() << " " << map.at(Integer(4)) << " " << map.at(Integer(37)) << " " << map.at(Integer(1111)) << std::endl;
+	sjtu::flat_map<Integer, int, Compare> one;
+	for (int i = 0; i < 3000; ++i) {
+		one.insert(batch[i]);
+	}
+	bool same = true;
+	for (int i = 0; i < 2000; ++i) {
+		same = same && (i % 2 == 0 && i < 1000 ? map.at(Integer(i)) == -i : map.at(Integer(i)) == one.at(Integer(i)));
+	}
+	std::cout << same << " " << map.insert_batch(batch, batch) << std::endl;
+	for (int i = 0; i < 3000; ++i) {
+		batch[i].~pair();
+	}
+	::operator delete(batch);
+}
+
+struct Entry {
+	int first;
+	int second;
+};
+
+std::istream &operator >> (std::istream &is, Entry &e) {
+	return is >> e.first >> e.second;
+}
+
+// yields its pairs by value, so there is no element to take the address of
+class Squares {
+public:
+	int i;
+	explicit Squares(int i) : i(i) {}
+	sjtu::pair<int, int> operator * () const {
+		return sjtu::pair<int, int>(i % 7, i * i);
+	}
+	Squares &operator ++ () {
+		++i;
+		return *this;
+	}
+	bool operator != (const Squares &rhs) const {
+		return i != rhs.i;
+	}
+};
+
+class Brittle {
+public:
+	static int live;
+	static int copiesLeft;
+	int val;
+	Brittle(int val) : val(val) {
+		live++;
+	}
+	Brittle(const Brittle &rhs) : val(rhs.val) {
+		if (copiesLeft == 0) {
+			throw sjtu::runtime_error();
+		}
+		copiesLeft--;
+		live++;
+	}
+	Brittle& operator = (const Brittle &rhs) {
+		val = rhs.val;
+		return *this;
+	}
+	~Brittle() {
+		live--;
+	}
+};
+
+int Brittle::live = 0;
+int Brittle::copiesLeft = -1;
+
+void tester_batch_ranges(void) {
+	sjtu::flat_map<int, int> map;
+	map[3] = 30;
+	std::istringstream in("5 50 1 10 3 -1 5 -5 2 20");
+	size_t inserted = map.insert_batch(std::istream_iterator<Entry>(in), std::istream_iterator<Entry>());
+	std::cout << inserted << " " << map.size() << " " << map.at(1) << " " << map.at(3) << " " << map.at(5) << std::endl;
+	inserted = map.insert_batch(Squares(0), Squares(20));
+	for (auto it = map.cbegin(); it != map.cend(); ++it) {
+		std::cout << it->first << ":" << it->second << " ";
+	}
+	std::cout << inserted << std::endl;
+	{
+		sjtu::flat_map<int, Brittle> bmap;
+		for (int i = 0; i < 20; i += 2) {
+			bmap.insert(sjtu::pair<const int, Brittle>(i, Brittle(i)));
+		}
+		sjtu::pair<int, Brittle> *batch = (sjtu::pair<int, Brittle> *)::operator new(10 * sizeof(sjtu::pair<int, Brittle>));
+		for (int i = 0; i < 10; ++i) {
+			new (batch + i) sjtu::pair<int, Brittle>(i * 2 + 1, Brittle(-i));
+		}
+		for (int left = 3; left <= 24; left += 7) {
+			Brittle::copiesLeft = left;
+			try {
+				bmap.insert_batch(batch, batch + 10);
+			} catch (...) {
+				std::cout << "exceptions thrown correctly." << std::endl;
+			}
+			int sum = 0;
+			for (auto it = bmap.cbegin(); it != bmap.cend(); ++it) {
+				sum += it->second.val;
+			}
+			std::cout << bmap.size() << " " << sum << " " << Brittle::live << std::endl;
+		}
+		Brittle::copiesLeft = -1;
+		std::cout << bmap.insert_batch(batch, batch + 10) << " " << bmap.size() << " " << bmap.at(7).val << std::endl;
+		for (int i = 0; i < 10; ++i) {
+			batch[i].~pair();
+		}
+		::operator delete(batch);
+	}
+	std::cout << Brittle::live << std::endl;
+}
+
+class Directed {
+public:
+	bool descending;
+	Directed() : descending(false) {}
+	explicit Directed(bool d) : descending(d) {}
+	bool operator()(int a, int b) const { return descending ? b < a : a < b; }
+};
+
+void tester_stateful_compare(void) {
+	sjtu::flat_map<int, int, Directed> down{Directed(true)};
+	for (int i = 0; i < 10; ++i) {
+		down[i] = i * i;
+	}
+	sjtu::flat_map<int, int, Directed> up;
+	up[3] = 0;
+	up = down;
+	up[10] = 100;
+	up.insert(sjtu::pair<const int, int>(-1, 1));
+	for (auto it = up.cbegin(); it != up.cend(); ++it) {
+		std::cout << it->first << " ";
+	}
+	std::cout << up.size() << " " << (up.find(7) != up.end()) << " " << up.at(9) << std::endl;
+}
+
+int main(void) {
+	tester_api();
+	tester_against_map();
+	tester_batch();
+	tester_batch_ranges();
+	tester_stateful_compare();
+	std::cout << Integer::counter << std::endl;
+	return 0;
+}
@@ -0,0 +1,724 @@
+/**
+ * a sorted-array map with the interface of sjtu::map
+ */
+#ifndef SJTU_FLAT_MAP_HPP
+#define SJTU_FLAT_MAP_HPP
+
+// only for std::less<T>
+#include <functional>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "utility.hpp"
+#include "exceptions.hpp"
+
+namespace sjtu
+{
+
+    /**
+     * keys and values live in two parallel arrays sorted by key, so a lookup
+     * only walks the dense key array and costs no pointer chasing and no
+     * allocation per element. lookups are O(log n), insert and erase shift
+     * the tail and are O(n); insert_batch merges many keys in one O(n + m) pass.
+     *
+     * the elements are not stored as pair objects, so dereferencing an
+     * iterator gives a (first, second) pair of references instead of a
+     * value_type&; it->first and it->second work as they do with sjtu::map.
+     * any insertion or erasure invalidates iterators and references.
+     */
+    template<
+            class Key,
+            class T,
+            class Compare = std::less<Key>
+    >
+    class flat_map
+    {
+    public:
+        typedef pair<const Key, T> value_type;
+
+        struct reference
+        {
+            const Key &first;
+            T &second;
+        };
+
+        struct const_reference
+        {
+            const Key &first;
+            const T &second;
+        };
+
+    private:
+        Key *keys;
+        T *values;
+        size_t num;
+        size_t cap;
+        Compare cmp;
+
+        /**
+         * gives operator-> something to point at.
+         */
+        template<class Ref>
+        class arrow
+        {
+            Ref ref;
+
+        public:
+            arrow(const Ref &r) : ref(r)
+            {}
+
+            const Ref *operator->() const
+            {
+                return &ref;
+            }
+        };
+
+    public:
+        class const_iterator;
+
+        class iterator
+        {
+            friend class flat_map;
+
+        private:
+            flat_map *mp;
+            size_t pos;
+
+        public:
+            iterator() : mp(nullptr), pos(0)
+            {}
+
+            iterator(flat_map *_mp, size_t _pos) : mp(_mp), pos(_pos)
+            {}
+
+            iterator operator++(int)
+            {
+                iterator it = *this;
+                ++(*this);
+                return it;
+            }
+
+            iterator &operator++()
+            {
+                if (mp == nullptr || pos == mp->num) throw invalid_iterator();
+                ++pos;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                iterator it = *this;
+                --(*this);
+                return it;
+            }
+
+            iterator &operator--()
+            {
+                if (mp == nullptr || pos == 0) throw invalid_iterator();
+                --pos;
+                return *this;
+            }
+
+            reference operator*() const
+            {
+                reference ref = {mp->keys[pos], mp->values[pos]};
+                return ref;
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return mp == rhs.mp && pos == rhs.pos;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return mp == rhs.mp && pos == rhs.pos;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return mp != rhs.mp || pos != rhs.pos;
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return mp != rhs.mp || pos != rhs.pos;
+            }
+
+            arrow<reference> operator->() const
+            {
+                return arrow<reference>(**this);
+            }
+        };
+
+        class const_iterator
+        {
+            friend class flat_map;
+
+        private:
+            const flat_map *mp;
+            size_t pos;
+
+        public:
+            const_iterator() : mp(nullptr), pos(0)
+            {}
+
+            const_iterator(const iterator &other) : mp(other.mp), pos(other.pos)
+            {}
+
+            const_iterator(const flat_map *_mp, size_t _pos) : mp(_mp), pos(_pos)
+            {}
+
+            const_iterator operator++(int)
+            {
+                const_iterator it = *this;
+                ++(*this);
+                return it;
+            }
+
+            const_iterator &operator++()
+            {
+                if (mp == nullptr || pos == mp->num) throw invalid_iterator();
+                ++pos;
+                return *this;
+            }
+
+            const_iterator operator--(int)
+            {
+                const_iterator it = *this;
+                --(*this);
+                return it;
+            }
+
+            const_iterator &operator--()
+            {
+                if (mp == nullptr || pos == 0) throw invalid_iterator();
+                --pos;
+                return *this;
+            }
+
+            const_reference operator*() const
+            {
+                const_reference ref = {mp->keys[pos], mp->values[pos]};
+                return ref;
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return mp == rhs.mp && pos == rhs.pos;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return mp == rhs.mp && pos == rhs.pos;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return mp != rhs.mp || pos != rhs.pos;
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return mp != rhs.mp || pos != rhs.pos;
+            }
+
+            arrow<const_reference> operator->() const
+            {
+                return arrow<const_reference>(**this);
+            }
+        };
+
+    private:
+        template<class U>
+        static U *allocate(size_t n)
+        {
+            return n == 0 ? nullptr : static_cast<U *>(::operator new(n * sizeof(U)));
+        }
+
+        template<class U>
+        static void destroy(U *a, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i) a[i].~U();
+        }
+
+        /**
+         * moves a[from, n) one slot up, leaving a[from] raw.
+         * only construction is used, so keys need no assignment operator.
+         */
+        template<class U>
+        static void shiftUp(U *a, size_t from, size_t n)
+        {
+            for (size_t i = n; i > from; --i)
+            {
+                new(a + i) U(std::move(a[i - 1]));
+                a[i - 1].~U();
+            }
+        }
+
+        /**
+         * destroys a[at] and moves a[at + 1, n) one slot down.
+         */
+        template<class U>
+        static void shiftDown(U *a, size_t at, size_t n)
+        {
+            a[at].~U();
+            for (size_t i = at + 1; i < n; ++i)
+            {
+                new(a + i - 1) U(std::move(a[i]));
+                a[i].~U();
+            }
+        }
+
+        void reallocate(size_t newCap)
+        {
+            Key *k = allocate<Key>(newCap);
+            T *v = allocate<T>(newCap);
+            for (size_t i = 0; i < num; ++i)
+            {
+                new(k + i) Key(std::move(keys[i]));
+                new(v + i) T(std::move(values[i]));
+            }
+            release();
+            keys = k;
+            values = v;
+            cap = newCap;
+        }
+
+        void release()
+        {
+            destroy(keys, num);
+            destroy(values, num);
+            ::operator delete(keys);
+            ::operator delete(values);
+        }
+
+        /**
+         * index of the first key not less than key, num if there is none.
+         * the loop halves the range without a data-dependent branch, so the
+         * compiler can turn the step into a conditional move and the cpu has
+         * nothing to mispredict.
+         */
+        size_t lowerBound(const Key &key) const
+        {
+            const Key *base = keys;
+            size_t n = num;
+            while (n > 1)
+            {
+                size_t half = n / 2;
+                base = cmp(base[half - 1], key) ? base + half : base;
+                n -= half;
+            }
+            return (base - keys) + (n == 1 && cmp(*base, key));
+        }
+
+        /**
+         * index of key, num if it is absent.
+         */
+        size_t locate(const Key &key) const
+        {
+            size_t i = lowerBound(key);
+            if (i < num && !cmp(key, keys[i])) return i;
+            return num;
+        }
+
+        template<class V>
+        void insertAt(size_t i, const Key &key, V &&value)
+        {
+            //key and value may live in the arrays that are about to move
+            Key k(key);
+            T v(std::forward<V>(value));
+            if (num == cap) reallocate(cap == 0 ? 16 : cap * 2);
+            shiftUp(keys, i, num);
+            shiftUp(values, i, num);
+            new(keys + i) Key(std::move(k));
+            new(values + i) T(std::move(v));
+            ++num;
+        }
+
+        /**
+         * constructs the element (key, value) at k and v; if the value
+         * throws, the key is destroyed again.
+         */
+        template<class K, class V>
+        static void construct(Key *k, T *v, K &&key, V &&value)
+        {
+            new(k) Key(std::forward<K>(key));
+            try
+            {
+                new(v) T(std::forward<V>(value));
+            } catch (...)
+            {
+                k->~Key();
+                throw;
+            }
+        }
+
+        typedef std::integral_constant<bool, std::is_nothrow_move_constructible<Key>::value
+                                             && std::is_nothrow_move_constructible<T>::value> nothrow_movable;
+
+        /**
+         * how insert_batch carries the old elements over: moved when no
+         * move can throw, copied otherwise, so the old arrays are still
+         * intact if the merge throws half-way.
+         */
+        template<class U>
+        static typename std::conditional<nothrow_movable::value, U &&, const U &>::type transfer(U &x)
+        {
+            return std::move(x);
+        }
+
+        /**
+         * an element of an insert_batch range, copied out of the range.
+         */
+        struct entry
+        {
+            Key first;
+            T second;
+        };
+
+        /**
+         * the range of insert_batch copied into one buffer, so it is read
+         * once; order holds the entries sorted by key and at the index each
+         * kept entry goes in front of. the destructor frees everything
+         * however insert_batch is left.
+         */
+        struct batch_buffer
+        {
+            entry *data;
+            entry **order;
+            size_t *at;
+            size_t num;
+            size_t cap;
+
+            batch_buffer() : data(nullptr), order(nullptr), at(nullptr), num(0), cap(0)
+            {}
+
+            ~batch_buffer()
+            {
+                destroy(data, num);
+                ::operator delete(data);
+                ::operator delete(order);
+                ::operator delete(at);
+            }
+
+            template<class E>
+            void push(const E &e)
+            {
+                if (num == cap) grow();
+                new(data + num) entry{Key(e.first), T(e.second)};
+                ++num;
+            }
+
+            void grow()
+            {
+                size_t newCap = cap == 0 ? 16 : cap * 2;
+                entry *p = allocate<entry>(newCap);
+                size_t k = 0;
+                try
+                {
+                    for (; k < num; ++k) new(p + k) entry(std::move_if_noexcept(data[k]));
+                } catch (...)
+                {
+                    destroy(p, k);
+                    ::operator delete(p);
+                    throw;
+                }
+                destroy(data, num);
+                ::operator delete(data);
+                data = p;
+                cap = newCap;
+            }
+        };
+
+        /**
+         * stable bottom-up merge sort of the batch by key.
+         */
+        template<class P>
+        void sortBatch(P *a, size_t n) const
+        {
+            P *tmp = allocate<P>(n);
+            try
+            {
+                for (size_t width = 1; width < n; width *= 2)
+                {
+                    for (size_t lo = 0; lo < n; lo += 2 * width)
+                    {
+                        size_t mid = lo + width < n ? lo + width : n;
+                        size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+                        size_t i = lo, j = mid, k = lo;
+                        while (i < mid && j < hi)
+                        {
+                            if (cmp(a[j]->first, a[i]->first)) new(tmp + k++) P(a[j++]);
+                            else new(tmp + k++) P(a[i++]);
+                        }
+                        while (i < mid) new(tmp + k++) P(a[i++]);
+                        while (j < hi) new(tmp + k++) P(a[j++]);
+                    }
+                    for (size_t i = 0; i < n; ++i) a[i] = tmp[i];
+                }
+            } catch (...)
+            {
+                ::operator delete(tmp);
+                throw;
+            }
+            ::operator delete(tmp);
+        }
+
+    public:
+        flat_map() : keys(nullptr), values(nullptr), num(0), cap(0)
+        {}
+
+        /**
+         * an empty map ordered by c, for comparators that carry state.
+         */
+        explicit flat_map(const Compare &c) : keys(nullptr), values(nullptr), num(0), cap(0), cmp(c)
+        {}
+
+        flat_map(const flat_map &other) : keys(allocate<Key>(other.num)), values(allocate<T>(other.num)), num(0), cap(other.num), cmp(other.cmp)
+        {
+            for (; num < other.num; ++num)
+            {
+                new(keys + num) Key(other.keys[num]);
+                new(values + num) T(other.values[num]);
+            }
+        }
+
+        flat_map &operator=(const flat_map &other)
+        {
+            if (this == &other) return *this;
+            //the keys arrive in the order of other.cmp, so search them with it
+            cmp = other.cmp;
+            clear();
+            if (other.num > cap) reallocate(other.num);
+            for (; num < other.num; ++num)
+            {
+                new(keys + num) Key(other.keys[num]);
+                new(values + num) T(other.values[num]);
+            }
+            return *this;
+        }
+
+        ~flat_map()
+        {
+            release();
+        }
+
+        /**
+         * access specified element with bounds checking
+         * Returns a reference to the mapped value of the element with key equivalent to key.
+         * If no such element exists, an exception of type `index_out_of_bound'
+         */
+        T &at(const Key &key)
+        {
+            size_t i = locate(key);
+            if (i == num) throw index_out_of_bound();
+            return values[i];
+        }
+
+        const T &at(const Key &key) const
+        {
+            size_t i = locate(key);
+            if (i == num) throw index_out_of_bound();
+            return values[i];
+        }
+
+        /**
+         * access specified element
+         * Returns a reference to the value that is mapped to a key equivalent to key,
+         *   performing an insertion if such key does not already exist.
+         * one search serves both the lookup and the insertion.
+         */
+        T &operator[](const Key &key)
+        {
+            size_t i = lowerBound(key);
+            if (i < num && !cmp(key, keys[i])) return values[i];
+            insertAt(i, key, T());
+            return values[i];
+        }
+
+        /**
+         * behave like at() throw index_out_of_bound if such key does not exist.
+         */
+        const T &operator[](const Key &key) const
+        {
+            return at(key);
+        }
+
+        iterator begin()
+        {
+            return iterator(this, 0);
+        }
+
+        const_iterator cbegin() const
+        {
+            return const_iterator(this, 0);
+        }
+
+        iterator end()
+        {
+            return iterator(this, num);
+        }
+
+        const_iterator cend() const
+        {
+            return const_iterator(this, num);
+        }
+
+        bool empty() const
+        {
+            return num == 0;
+        }
+
+        size_t size() const
+        {
+            return num;
+        }
+
+        size_t capacity() const
+        {
+            return cap;
+        }
+
+        void reserve(size_t n)
+        {
+            if (n > cap) reallocate(n);
+        }
+
+        /**
+         * clears the contents, keeping the arrays for reuse.
+         */
+        void clear()
+        {
+            destroy(keys, num);
+            destroy(values, num);
+            num = 0;
+        }
+
+        /**
+         * insert an element.
+         * return a pair, the first of the pair is
+         *   the iterator to the new element (or the element that prevented the insertion),
+         *   the second one is true if insert successfully, or false.
+         */
+        pair<iterator, bool> insert(const value_type &value)
+        {
+            size_t i = lowerBound(value.first);
+            if (i < num && !cmp(value.first, keys[i])) return pair<iterator, bool>(iterator(this, i), false);
+            insertAt(i, value.first, value.second);
+            return pair<iterator, bool>(iterator(this, i), true);
+        }
+
+        /**
+         * inserts every element of the range [first, last), whose elements have .first
+         * and .second like value_type. keys already present are left alone,
+         * and of equal keys inside the batch the earliest one wins, as if the
+         * batch had been inserted one by one.
+         * the range is read once into a buffer, which is sorted and then merged
+         * with the map in one pass, so a batch of m costs O(m log m + n)
+         * instead of m separate O(n) inserts.
+         * if anything throws, the map is left as it was.
+         * returns the number of elements inserted.
+         */
+        template<class InputIterator>
+        size_t insert_batch(InputIterator first, InputIterator last)
+        {
+            batch_buffer batch;
+            for (; first != last; ++first) batch.push(*first);
+            size_t m = batch.num;
+            if (m == 0) return 0;
+            batch.order = allocate<entry *>(m);
+            for (size_t j = 0; j < m; ++j) batch.order[j] = batch.data + j;
+            sortBatch(batch.order, m);
+
+            //all the comparisons happen before anything moves: entries whose
+            //key the map has or an earlier entry repeats are dropped, and the
+            //rest record the index of the first key greater than theirs
+            batch.at = allocate<size_t>(m);
+            size_t kept = 0;
+            for (size_t i = 0, j = 0; j < m; ++j)
+            {
+                const Key &key = batch.order[j]->first;
+                while (i < num && cmp(keys[i], key)) ++i;
+                bool present = i < num && !cmp(key, keys[i]);
+                bool repeated = j > 0 && !cmp(batch.order[j - 1]->first, key);
+                if (present || repeated) continue;
+                batch.at[kept] = i;
+                batch.order[kept++] = batch.order[j];
+            }
+            if (kept == 0) return 0;
+
+            size_t newCap = num + kept;
+            Key *newKeys = allocate<Key>(newCap);
+            T *newValues = nullptr;
+            size_t i = 0, n = 0;
+            try
+            {
+                newValues = allocate<T>(newCap);
+                for (size_t j = 0; j < kept; ++j)
+                {
+                    for (; i < batch.at[j]; ++i, ++n)
+                        construct(newKeys + n, newValues + n, transfer(keys[i]), transfer(values[i]));
+                    construct(newKeys + n, newValues + n, std::move(batch.order[j]->first), std::move(batch.order[j]->second));
+                    ++n;
+                }
+                for (; i < num; ++i, ++n)
+                    construct(newKeys + n, newValues + n, transfer(keys[i]), transfer(values[i]));
+            } catch (...)
+            {
+                destroy(newKeys, n);
+                destroy(newValues, n);
+                ::operator delete(newKeys);
+                ::operator delete(newValues);
+                throw;
+            }
+            release();
+            keys = newKeys;
+            values = newValues;
+            num = n;
+            cap = newCap;
+            return kept;
+        }
+
+        /**
+         * erase the element at pos.
+         *
+         * throw if pos pointed to a bad element (pos == this->end() || pos points an element out of this)
+         */
+        void erase(iterator pos)
+        {
+            if (pos.mp != this || pos.pos >= num) throw invalid_iterator();
+            shiftDown(keys, pos.pos, num);
+            shiftDown(values, pos.pos, num);
+            --num;
+        }
+
+        /**
+         * Returns the number of elements with key
+         *   that compares equivalent to the specified argument,
+         *   which is either 1 or 0
+         *     since this container does not allow duplicates.
+         */
+        size_t count(const Key &key) const
+        {
+            return locate(key) == num ? 0 : 1;
+        }
+
+        /**
+         * Finds an element with key equivalent to key.
+         *   If no such element is found, past-the-end (see end()) iterator is returned.
+         */
+        iterator find(const Key &key)
+        {
+            return iterator(this, locate(key));
+        }
+
+        const_iterator find(const Key &key) const
+        {
+            return const_iterator(this, locate(key));
+        }
+    };
+}
+
+#endif
@@ -7,16 +7,23 @@
 // only for std::less<T>
 #include <functional>
 #include <cstddef>
+#include <memory>
+#include <new>
 #include "utility.hpp"
 #include "exceptions.hpp"
+#include "allocator.hpp"
 
 namespace sjtu
 {
 
+    /**
+     * nodes come from Alloc rebound to the node type; see allocator.hpp.
+     */
     template<
             class Key,
             class T,
-            class Compare = std::less<Key>
+            class Compare = std::less<Key>,
+            class Alloc = allocator<pair<const Key, T> >
     >
     class map
     {
@@ -27,6 +34,7 @@ namespace sjtu
          * You can use sjtu::map as value_type by typedef.
          */
         typedef pair<const Key, T> value_type;
+        typedef Alloc allocator_type;
         enum Color
         {
             RED, BLACK
@@ -46,9 +54,13 @@ namespace sjtu
             {}
         };
 
+        typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Node> node_allocator;
+        typedef std::allocator_traits<node_allocator> node_traits;
+
         Node *root;
         size_t num;
         Compare cmp;
+        node_allocator alloc;
 
     public:
         /**
@@ -309,10 +321,30 @@ namespace sjtu
         };
 
     private:
+        Node *newNode(const value_type &value, Color color = RED)
+        {
+            Node *t = node_traits::allocate(alloc, 1);
+            try
+            {
+                new(t) Node(value, color);
+            } catch (...)
+            {
+                node_traits::deallocate(alloc, t, 1);
+                throw;
+            }
+            return t;
+        }
+
+        void deleteNode(Node *t)
+        {
+            t->~Node();
+            node_traits::deallocate(alloc, t, 1);
+        }
+
         Node *create(Node *o, Node *p = nullptr)
         {
             if (o == nullptr) return nullptr;
-            Node *t = new Node(o->value, o->color);
+            Node *t = newNode(o->value, o->color);
             t->parent = p;
             t->left = create(o->left, t);
             t->right = create(o->right, t);
@@ -324,7 +356,7 @@ namespace sjtu
             if (t == nullptr) return;
             _clear(t->left);
             _clear(t->right);
-            delete t;
+            deleteNode(t);
         }
 
     public:
@@ -334,7 +366,10 @@ namespace sjtu
         map() : root(nullptr), num(0)
         {}
 
-        map(const map &other) : num(other.num)
+        explicit map(const Alloc &a) : root(nullptr), num(0), alloc(a)
+        {}
+
+        map(const map &other) : num(other.num), cmp(other.cmp), alloc(node_traits::select_on_container_copy_construction(other.alloc))
         {
             root = create(other.root);
         }
@@ -345,6 +380,7 @@ namespace sjtu
         map &operator=(const map &other)
         {
             if (this == &other) return *this;
+            cmp = other.cmp;
             _clear(root);
             num = other.num;
             root = create(other.root);
@@ -450,6 +486,11 @@ namespace sjtu
             return num;
         }
 
+        Alloc get_allocator() const
+        {
+            return Alloc(alloc);
+        }
+
         /**
          * clears the contents
          */
@@ -528,8 +569,8 @@ namespace sjtu
 
         Node *_insert(const value_type &value)
         {
+            Node *newNode = this->newNode(value);
             num++;
-            Node *newNode = new Node(value);
             Node *t = root, *p = nullptr;
             while (t != nullptr)
             {
@@ -631,7 +672,7 @@ namespace sjtu
                 t->left->parent = replace;
             }
             if (col == BLACK) eraseRebalance(replace, col);
-            delete t;
+            deleteNode(t);
         }
 
         void eraseRebalance(Node *t, Color delColor)
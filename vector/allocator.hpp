@@ -0,0 +1,157 @@
+#ifndef SJTU_ALLOCATOR_HPP
+#define SJTU_ALLOCATOR_HPP
+
+#include "huge_pages.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace sjtu
+{
+/**
+ * the default allocator of the sjtu containers, following the standard
+ * allocator model: value_type, allocate(n), deallocate(p, n), a converting
+ * constructor for rebinding and ==. the containers reach it through
+ * std::allocator_traits, so any allocator with that interface plugs in.
+ *
+ * memory comes from operator new, or from huge_pages when the build
+ * enables it (see huge_pages.hpp).
+ */
+    template<class T>
+    class allocator
+    {
+    public:
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_move_assignment;
+
+        allocator() noexcept
+        {}
+
+        template<class U>
+        allocator(const allocator<U> &) noexcept
+        {}
+
+        /**
+         * throw std::bad_array_new_length if n*sizeof(T) does not fit in size_t
+         */
+        T *allocate(size_t n)
+        {
+            if(n>size_t(-1)/sizeof(T)) throw std::bad_array_new_length();
+            return static_cast<T *>(huge_pages::allocate(n*sizeof(T)));
+        }
+
+        void deallocate(T *p, size_t n) noexcept
+        {
+            huge_pages::deallocate(p, n*sizeof(T));
+        }
+
+        template<class U>
+        bool operator==(const allocator<U> &) const noexcept
+        {
+            return true;
+        }
+
+        template<class U>
+        bool operator!=(const allocator<U> &) const noexcept
+        {
+            return false;
+        }
+    };
+
+    /**
+     * what a counting_allocator has done so far.
+     */
+    struct allocation_stats
+    {
+        std::atomic<size_t> allocations;
+        std::atomic<size_t> deallocations;
+        std::atomic<size_t> bytes;
+
+        allocation_stats() : allocations(0), deallocations(0), bytes(0)
+        {}
+
+        /**
+         * blocks handed out and not yet returned.
+         */
+        size_t live() const
+        {
+            return allocations.load()-deallocations.load();
+        }
+
+        /**
+         * the process-wide stats used by default constructed allocators.
+         */
+        static allocation_stats &global()
+        {
+            static allocation_stats stats;
+            return stats;
+        }
+    };
+
+    /**
+     * a test allocator that counts allocations, deallocations and live bytes
+     * into an allocation_stats, then forwards to operator new.
+     * copies and rebinds share the stats they were made from, and two
+     * counting allocators compare equal when they share stats.
+     */
+    template<class T>
+    class counting_allocator
+    {
+        template<class U>
+        friend class counting_allocator;
+
+    private:
+        allocation_stats *stats;
+
+    public:
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_move_assignment;
+
+        counting_allocator() noexcept : stats(&allocation_stats::global())
+        {}
+
+        explicit counting_allocator(allocation_stats &s) noexcept : stats(&s)
+        {}
+
+        template<class U>
+        counting_allocator(const counting_allocator<U> &other) noexcept : stats(other.stats)
+        {}
+
+        T *allocate(size_t n)
+        {
+            if(n>size_t(-1)/sizeof(T)) throw std::bad_array_new_length();
+            T *p=static_cast<T *>(::operator new(n*sizeof(T)));
+            stats->allocations++;
+            stats->bytes+=n*sizeof(T);
+            return p;
+        }
+
+        void deallocate(T *p, size_t n) noexcept
+        {
+            stats->deallocations++;
+            stats->bytes-=n*sizeof(T);
+            ::operator delete(p);
+        }
+
+        allocation_stats &statistics() const
+        {
+            return *stats;
+        }
+
+        template<class U>
+        bool operator==(const counting_allocator<U> &other) const noexcept
+        {
+            return stats==other.stats;
+        }
+
+        template<class U>
+        bool operator!=(const counting_allocator<U> &other) const noexcept
+        {
+            return stats!=other.stats;
+        }
+    };
+}
+
+#endif
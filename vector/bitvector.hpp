@@ -0,0 +1,721 @@
+#ifndef SJTU_BITVECTOR_HPP
+#define SJTU_BITVECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+namespace sjtu
+{
+/**
+ * a vector of bools packed one bit each into 64-bit words, so a mask over
+ * 10^9 rows takes 125MB. element access goes through a proxy reference;
+ * count, find_first/find_next and the &, |, ^ operators work a word at a
+ * time with popcount and count-trailing-zeros.
+ *
+ * rank(i), the number of set bits before i, sums whole words with
+ * popcount; after build_rank() it is O(1) from a table of counts per
+ * 512 bits. any later modification drops the table until the next
+ * build_rank().
+ *
+ * bits past size() in the last word are always zero.
+ */
+    class bitvector
+    {
+    private:
+        static const size_t WORD_BITS=64;
+        static const size_t BLOCK_WORDS=8;
+
+        uint64_t *words;
+        size_t _size;
+        size_t _capacity;
+        size_t *blockRank;
+        bool rankStale;
+
+        static size_t wordsFor(size_t bits)
+        {
+            return (bits+WORD_BITS-1)/WORD_BITS;
+        }
+
+        static uint64_t bit(size_t pos)
+        {
+            return uint64_t(1)<<(pos%WORD_BITS);
+        }
+
+        static size_t popcount(uint64_t x)
+        {
+            return __builtin_popcountll(x);
+        }
+
+        static size_t lowestBit(uint64_t x)
+        {
+            return __builtin_ctzll(x);
+        }
+
+        /**
+         * ones in the last word's used bits, zeros past them.
+         */
+        uint64_t tailMask() const
+        {
+            size_t used=_size%WORD_BITS;
+            return used==0?~uint64_t(0):(uint64_t(1)<<used)-1;
+        }
+
+        void clearTail()
+        {
+            if(_size%WORD_BITS!=0) words[_size/WORD_BITS]&=tailMask();
+        }
+
+        void modified()
+        {
+            rankStale=true;
+        }
+
+        void reallocate(size_t newCapacity)
+        {
+            uint64_t *temp=newCapacity?static_cast<uint64_t *>(::operator new(newCapacity*sizeof(uint64_t))):nullptr;
+            size_t used=wordsFor(_size);
+            if(used) std::memcpy(temp, words, used*sizeof(uint64_t));
+            ::operator delete(words);
+            words=temp;
+            _capacity=newCapacity;
+        }
+
+        /**
+         * makes room for n bits; new words are zeroed.
+         */
+        void growTo(size_t n)
+        {
+            size_t need=wordsFor(n);
+            if(need>_capacity) reallocate(need>_capacity*2?need:_capacity*2);
+            size_t used=wordsFor(_size);
+            if(need>used) std::memset(words+used, 0, (need-used)*sizeof(uint64_t));
+        }
+
+        void checkSameSize(const bitvector &other) const
+        {
+            if(_size!=other._size) throw runtime_error();
+        }
+
+    public:
+        /**
+         * a proxy for one bit; converts to bool and assigns from bool.
+         */
+        class reference
+        {
+            friend class bitvector;
+
+        private:
+            uint64_t *word;
+            uint64_t mask;
+            bool *stale;
+
+            reference(uint64_t *word, uint64_t mask, bool *stale) : word(word), mask(mask), stale(stale)
+            {}
+
+        public:
+            operator bool() const
+            {
+                return (*word&mask)!=0;
+            }
+
+            reference &operator=(bool value)
+            {
+                if(value) *word|=mask;
+                else *word&=~mask;
+                *stale=true;
+                return *this;
+            }
+
+            reference &operator=(const reference &other)
+            {
+                return *this=bool(other);
+            }
+
+            bool operator~() const
+            {
+                return (*word&mask)==0;
+            }
+
+            void flip()
+            {
+                *word^=mask;
+                *stale=true;
+            }
+        };
+
+        class const_iterator;
+
+        class iterator
+        {
+            friend class bitvector;
+
+        private:
+            bitvector *vec;
+            size_t ptr;
+
+        public:
+            iterator operator+(const int &n) const
+            {
+                iterator it=*this;
+                it.ptr+=n;
+                return it;
+            }
+
+            iterator operator-(const int &n) const
+            {
+                iterator it=*this;
+                it.ptr-=n;
+                return it;
+            }
+
+            // return the distance between two iterators,
+            // if these two iterators point to different vectors, throw invaild_iterator.
+            int operator-(const iterator &rhs) const
+            {
+                if(vec!=rhs.vec) throw invalid_iterator();
+                return ptr-rhs.ptr;
+            }
+
+            iterator &operator+=(const int &n)
+            {
+                ptr+=n;
+                return *this;
+            }
+
+            iterator &operator-=(const int &n)
+            {
+                ptr-=n;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator it=*this;
+                ptr++;
+                return it;
+            }
+
+            iterator &operator++()
+            {
+                ptr++;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                iterator it=*this;
+                ptr--;
+                return it;
+            }
+
+            iterator &operator--()
+            {
+                ptr--;
+                return *this;
+            }
+
+            reference operator*() const
+            {
+                return (*vec)[ptr];
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+        };
+
+        class const_iterator
+        {
+            friend class bitvector;
+
+        private:
+            const bitvector *vec;
+            size_t ptr;
+
+        public:
+            const_iterator operator+(const int &n) const
+            {
+                const_iterator it=*this;
+                it.ptr+=n;
+                return it;
+            }
+
+            const_iterator operator-(const int &n) const
+            {
+                const_iterator it=*this;
+                it.ptr-=n;
+                return it;
+            }
+
+            int operator-(const const_iterator &rhs) const
+            {
+                if(vec!=rhs.vec) throw invalid_iterator();
+                return ptr-rhs.ptr;
+            }
+
+            const_iterator &operator+=(const int &n)
+            {
+                ptr+=n;
+                return *this;
+            }
+
+            const_iterator &operator-=(const int &n)
+            {
+                ptr-=n;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator it=*this;
+                ptr++;
+                return it;
+            }
+
+            const_iterator &operator++()
+            {
+                ptr++;
+                return *this;
+            }
+
+            const_iterator operator--(int)
+            {
+                const_iterator it=*this;
+                ptr--;
+                return it;
+            }
+
+            const_iterator &operator--()
+            {
+                ptr--;
+                return *this;
+            }
+
+            bool operator*() const
+            {
+                return (*vec)[ptr];
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+        };
+
+        bitvector() : words(nullptr), _size(0), _capacity(0), blockRank(nullptr), rankStale(true)
+        {}
+
+        /**
+         * n bits, all set to value.
+         */
+        explicit bitvector(size_t n, bool value=false) : words(nullptr), _size(0), _capacity(0), blockRank(nullptr), rankStale(true)
+        {
+            resize(n, value);
+        }
+
+        bitvector(const bitvector &other) : words(nullptr), _size(0), _capacity(0), blockRank(nullptr), rankStale(true)
+        {
+            *this=other;
+        }
+
+        bitvector(bitvector &&other) noexcept
+                : words(other.words), _size(other._size), _capacity(other._capacity), blockRank(other.blockRank), rankStale(other.rankStale)
+        {
+            other.words=nullptr;
+            other.blockRank=nullptr;
+            other._size=other._capacity=0;
+            other.rankStale=true;
+        }
+
+        ~bitvector()
+        {
+            ::operator delete(words);
+            ::operator delete(blockRank);
+        }
+
+        bitvector &operator=(const bitvector &other)
+        {
+            if(this==&other) return *this;
+            size_t used=wordsFor(other._size);
+            if(used>_capacity) reallocate(used);
+            if(used) std::memcpy(words, other.words, used*sizeof(uint64_t));
+            _size=other._size;
+            modified();
+            return *this;
+        }
+
+        bitvector &operator=(bitvector &&other) noexcept
+        {
+            if(this==&other) return *this;
+            ::operator delete(words);
+            ::operator delete(blockRank);
+            words=other.words;
+            _size=other._size;
+            _capacity=other._capacity;
+            blockRank=other.blockRank;
+            rankStale=other.rankStale;
+            other.words=nullptr;
+            other.blockRank=nullptr;
+            other._size=other._capacity=0;
+            other.rankStale=true;
+            return *this;
+        }
+
+        /**
+         * access specified element with bounds checking
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        reference at(const size_t &pos)
+        {
+            if(pos>=_size) throw index_out_of_bound();
+            return reference(words+pos/WORD_BITS, bit(pos), &rankStale);
+        }
+
+        bool at(const size_t &pos) const
+        {
+            if(pos>=_size) throw index_out_of_bound();
+            return (words[pos/WORD_BITS]&bit(pos))!=0;
+        }
+
+        reference operator[](const size_t &pos)
+        {
+            return at(pos);
+        }
+
+        bool operator[](const size_t &pos) const
+        {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        bool front() const
+        {
+            if(_size==0) throw container_is_empty();
+            return (*this)[0];
+        }
+
+        bool back() const
+        {
+            if(_size==0) throw container_is_empty();
+            return (*this)[_size-1];
+        }
+
+        /**
+         * the packed words, bit i is bit i%64 of word i/64.
+         */
+        const uint64_t *data() const
+        {
+            return words;
+        }
+
+        iterator begin()
+        {
+            iterator it;
+            it.vec=this;
+            it.ptr=0;
+            return it;
+        }
+
+        const_iterator cbegin() const
+        {
+            const_iterator it;
+            it.vec=this;
+            it.ptr=0;
+            return it;
+        }
+
+        iterator end()
+        {
+            iterator it;
+            it.vec=this;
+            it.ptr=_size;
+            return it;
+        }
+
+        const_iterator cend() const
+        {
+            const_iterator it;
+            it.vec=this;
+            it.ptr=_size;
+            return it;
+        }
+
+        bool empty() const
+        {
+            return _size==0;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        /**
+         * the number of bits that fit without reallocation.
+         */
+        size_t capacity() const
+        {
+            return _capacity*WORD_BITS;
+        }
+
+        void clear()
+        {
+            _size=0;
+            modified();
+        }
+
+        void reserve(size_t n)
+        {
+            if(wordsFor(n)>_capacity) reallocate(wordsFor(n));
+        }
+
+        void resize(size_t n, bool value=false)
+        {
+            if(n>_size)
+            {
+                size_t old=_size;
+                growTo(n);
+                _size=n;
+                if(value) set(old, n, true);
+            } else
+            {
+                _size=n;
+                clearTail();
+            }
+            modified();
+        }
+
+        void push_back(bool value)
+        {
+            if(_size==_capacity*WORD_BITS) growTo(_size+1);
+            if(_size%WORD_BITS==0) words[_size/WORD_BITS]=0;
+            if(value) words[_size/WORD_BITS]|=bit(_size);
+            _size++;
+            modified();
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_back()
+        {
+            if(_size==0) throw container_is_empty();
+            _size--;
+            clearTail();
+            modified();
+        }
+
+        /**
+         * sets the bits in [first, last) to value, whole words at a time.
+         * throw index_out_of_bound if the range is not inside [0, size]
+         */
+        void set(size_t first, size_t last, bool value)
+        {
+            if(first>last||last>_size) throw index_out_of_bound();
+            while(first<last&&first%WORD_BITS!=0)
+            {
+                (*this)[first]=value;
+                first++;
+            }
+            size_t full=(last-first)/WORD_BITS;
+            std::memset(words+first/WORD_BITS, value?0xff:0, full*sizeof(uint64_t));
+            for(first+=full*WORD_BITS;first<last;++first)
+                (*this)[first]=value;
+            modified();
+        }
+
+        /**
+         * sets every bit to value.
+         */
+        void assign(bool value)
+        {
+            set(0, _size, value);
+        }
+
+        /**
+         * inverts every bit.
+         */
+        void flip()
+        {
+            size_t used=wordsFor(_size);
+            for(size_t i=0;i<used;++i)
+                words[i]=~words[i];
+            clearTail();
+            modified();
+        }
+
+        /**
+         * the number of set bits.
+         */
+        size_t count() const
+        {
+            size_t total=0, used=wordsFor(_size);
+            for(size_t i=0;i<used;++i)
+                total+=popcount(words[i]);
+            return total;
+        }
+
+        /**
+         * the index of the first set bit, size() if there is none.
+         */
+        size_t find_first() const
+        {
+            return find_next(0);
+        }
+
+        /**
+         * the index of the first set bit at or after pos, size() if there is none.
+         */
+        size_t find_next(size_t pos) const
+        {
+            if(pos>=_size) return _size;
+            size_t w=pos/WORD_BITS, used=wordsFor(_size);
+            uint64_t x=words[w]&(~uint64_t(0)<<(pos%WORD_BITS));
+            while(x==0)
+            {
+                if(++w==used) return _size;
+                x=words[w];
+            }
+            return w*WORD_BITS+lowestBit(x);
+        }
+
+        /**
+         * builds the table that makes rank O(1).
+         */
+        void build_rank()
+        {
+            size_t used=wordsFor(_size), blocks=used/BLOCK_WORDS+1;
+            ::operator delete(blockRank);
+            blockRank=nullptr;
+            blockRank=static_cast<size_t *>(::operator new(blocks*sizeof(size_t)));
+            size_t total=0;
+            for(size_t i=0;i<used;++i)
+            {
+                if(i%BLOCK_WORDS==0) blockRank[i/BLOCK_WORDS]=total;
+                total+=popcount(words[i]);
+            }
+            if(used%BLOCK_WORDS==0) blockRank[used/BLOCK_WORDS]=total;
+            rankStale=false;
+        }
+
+        /**
+         * the number of set bits in [0, pos).
+         * throw index_out_of_bound if pos > size
+         */
+        size_t rank(size_t pos) const
+        {
+            if(pos>_size) throw index_out_of_bound();
+            size_t w=pos/WORD_BITS, total=0, i=0;
+            if(!rankStale)
+            {
+                total=blockRank[w/BLOCK_WORDS];
+                i=w/BLOCK_WORDS*BLOCK_WORDS;
+            }
+            for(;i<w;++i)
+                total+=popcount(words[i]);
+            if(pos%WORD_BITS!=0) total+=popcount(words[w]&((uint64_t(1)<<(pos%WORD_BITS))-1));
+            return total;
+        }
+
+        /**
+         * word-wise logic with another bitvector of the same size.
+         * throw runtime_error if the sizes differ.
+         */
+        bitvector &operator&=(const bitvector &other)
+        {
+            checkSameSize(other);
+            size_t used=wordsFor(_size);
+            for(size_t i=0;i<used;++i)
+                words[i]&=other.words[i];
+            modified();
+            return *this;
+        }
+
+        bitvector &operator|=(const bitvector &other)
+        {
+            checkSameSize(other);
+            size_t used=wordsFor(_size);
+            for(size_t i=0;i<used;++i)
+                words[i]|=other.words[i];
+            modified();
+            return *this;
+        }
+
+        bitvector &operator^=(const bitvector &other)
+        {
+            checkSameSize(other);
+            size_t used=wordsFor(_size);
+            for(size_t i=0;i<used;++i)
+                words[i]^=other.words[i];
+            modified();
+            return *this;
+        }
+
+        bool operator==(const bitvector &other) const
+        {
+            return _size==other._size&&(_size==0||std::memcmp(words, other.words, wordsFor(_size)*sizeof(uint64_t))==0);
+        }
+
+        bool operator!=(const bitvector &other) const
+        {
+            return !(*this==other);
+        }
+    };
+
+    inline bitvector operator&(bitvector lhs, const bitvector &rhs)
+    {
+        lhs&=rhs;
+        return lhs;
+    }
+
+    inline bitvector operator|(bitvector lhs, const bitvector &rhs)
+    {
+        lhs|=rhs;
+        return lhs;
+    }
+
+    inline bitvector operator^(bitvector lhs, const bitvector &rhs)
+    {
+        lhs^=rhs;
+        return lhs;
+    }
+}
+
+#endif
@@ -0,0 +1,307 @@
+#ifndef SJTU_CONCURRENT_VECTOR_HPP
+#define SJTU_CONCURRENT_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu
+{
+/**
+ * an append-only vector that many threads can grow at once without a lock.
+ * push_back and grow_by reserve their slots with one atomic fetch-add, so
+ * producers never wait on each other. storage is a directory of segments
+ * of doubling size (32, 64, 128, ...), the layout of sjtu::stable_vector:
+ * growing only adds a segment, elements never move, and whichever thread
+ * first needs a segment installs it with a compare-and-swap.
+ *
+ * operator[] is wait-free. an index is safe to read once push_back or
+ * grow_by has returned it, and the reader has learned of it through some
+ * synchronization of its own (a join, a flag, a queue). size() counts
+ * reserved slots, some of which may still be under construction.
+ *
+ * clear(), assignment and destruction are not thread-safe.
+ * reserved slots cannot be given back, so if an element constructor
+ * throws, that slot and the not yet constructed rest of its push_back or
+ * grow_by are default constructed before the exception is rethrown. for
+ * that fallback to be safe T's default constructor must be noexcept.
+ */
+    template<typename T>
+    class concurrent_vector
+    {
+        static_assert(std::is_nothrow_default_constructible<T>::value,
+                      "concurrent_vector fills slots whose constructor threw with T(), which must be noexcept");
+
+    private:
+        static const size_t FIRST_SHIFT=5;
+        static const size_t FIRST=size_t(1)<<FIRST_SHIFT;
+        static const size_t MAX_SEGMENTS=sizeof(size_t)*8-FIRST_SHIFT;
+
+        std::atomic<T *> segments[MAX_SEGMENTS];
+        std::atomic<size_t> _size;
+
+        static size_t highBit(size_t x)
+        {
+            return sizeof(unsigned long long)*8-1-__builtin_clzll(x);
+        }
+
+        static size_t segmentOf(size_t i)
+        {
+            return highBit(i+FIRST)-FIRST_SHIFT;
+        }
+
+        static size_t segmentSize(size_t k)
+        {
+            return FIRST<<k;
+        }
+
+        /**
+         * the segment holding slot i, which must already be installed.
+         */
+        T *slot(size_t i) const
+        {
+            size_t j=i+FIRST, h=highBit(j);
+            return segments[h-FIRST_SHIFT].load(std::memory_order_acquire)+(j-(size_t(1)<<h));
+        }
+
+        /**
+         * installs segment k unless another thread got there first.
+         */
+        void ensureSegment(size_t k)
+        {
+            if(segments[k].load(std::memory_order_acquire)!=nullptr) return;
+            T *fresh=static_cast<T *>(::operator new(segmentSize(k)*sizeof(T)));
+            T *expected=nullptr;
+            if(!segments[k].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel))
+                ::operator delete(fresh);
+        }
+
+        /**
+         * reserves n consecutive slots and makes sure their segments exist.
+         */
+        size_t reserveSlots(size_t n)
+        {
+            size_t first=_size.fetch_add(n, std::memory_order_relaxed);
+            if(n==0) return first;
+            for(size_t k=segmentOf(first), last=segmentOf(first+n-1);k<=last;++k)
+                ensureSegment(k);
+            return first;
+        }
+
+        /**
+         * constructs slots [first, first+n) from args, which are not moved
+         * from, so they can serve every slot.
+         * the slots are already handed out and must all hold some value, so
+         * when a constructor throws, the failed slot and the rest of the
+         * range are default constructed before rethrowing.
+         */
+        template<typename... Args>
+        void constructRange(size_t first, size_t n, const Args &...args)
+        {
+            size_t i=0;
+            try
+            {
+                for(;i<n;++i)
+                    new(slot(first+i)) T(args...);
+            } catch(...)
+            {
+                for(;i<n;++i)
+                    new(slot(first+i)) T();
+                throw;
+            }
+        }
+
+        template<typename... Args>
+        void constructAt(size_t i, Args &&...args)
+        {
+            T *p=slot(i);
+            try
+            {
+                new(p) T(std::forward<Args>(args)...);
+            } catch(...)
+            {
+                new(p) T();
+                throw;
+            }
+        }
+
+        void destroyAll()
+        {
+            size_t n=_size.load(std::memory_order_relaxed);
+            for(size_t i=0;i<n;++i)
+                slot(i)->~T();
+            _size.store(0, std::memory_order_relaxed);
+        }
+
+        void releaseAll()
+        {
+            for(size_t k=0;k<MAX_SEGMENTS;++k)
+            {
+                ::operator delete(segments[k].load(std::memory_order_relaxed));
+                segments[k].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+    public:
+        /**
+         * no segment is allocated until the first element arrives.
+         */
+        concurrent_vector() : _size(0)
+        {
+            for(size_t k=0;k<MAX_SEGMENTS;++k)
+                segments[k].store(nullptr, std::memory_order_relaxed);
+        }
+
+        concurrent_vector(const concurrent_vector &other) : concurrent_vector()
+        {
+            size_t n=other.size();
+            reserveSlots(n);
+            size_t i=0;
+            try
+            {
+                for(;i<n;++i)
+                    new(slot(i)) T(other[i]);
+            } catch(...)
+            {
+                //the delegated constructor has finished, so the destructor
+                //runs next: leave it only the slots that were constructed
+                _size.store(i, std::memory_order_relaxed);
+                throw;
+            }
+        }
+
+        concurrent_vector &operator=(const concurrent_vector &)=delete;
+
+        ~concurrent_vector()
+        {
+            destroyAll();
+            releaseAll();
+        }
+
+        /**
+         * access specified element with bounds checking
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        T &at(const size_t &pos)
+        {
+            if(pos>=size()) throw index_out_of_bound();
+            return *slot(pos);
+        }
+
+        const T &at(const size_t &pos) const
+        {
+            if(pos>=size()) throw index_out_of_bound();
+            return *slot(pos);
+        }
+
+        /**
+         * wait-free, unchecked: pos must be an index some push_back or
+         * grow_by has already returned.
+         */
+        T &operator[](const size_t &pos)
+        {
+            return *slot(pos);
+        }
+
+        const T &operator[](const size_t &pos) const
+        {
+            return *slot(pos);
+        }
+
+        bool empty() const
+        {
+            return size()==0;
+        }
+
+        /**
+         * slots reserved so far, including ones still being constructed.
+         */
+        size_t size() const
+        {
+            return _size.load(std::memory_order_acquire);
+        }
+
+        /**
+         * elements the installed segments can hold.
+         * segments are installed in order, except that a racing grow may
+         * install a later one first; those are not counted.
+         */
+        size_t capacity() const
+        {
+            size_t total=0;
+            for(size_t k=0;k<MAX_SEGMENTS&&segments[k].load(std::memory_order_acquire)!=nullptr;++k)
+                total+=segmentSize(k);
+            return total;
+        }
+
+        /**
+         * installs segments for the first n slots ahead of time.
+         */
+        void reserve(size_t n)
+        {
+            if(n==0) return;
+            for(size_t k=0, last=segmentOf(n-1);k<=last;++k)
+                ensureSegment(k);
+        }
+
+        /**
+         * destroys every element, keeping the segments. not thread-safe.
+         */
+        void clear()
+        {
+            destroyAll();
+        }
+
+        /**
+         * appends value, returns the index it was stored at.
+         */
+        size_t push_back(const T &value)
+        {
+            size_t i=reserveSlots(1);
+            constructAt(i, value);
+            return i;
+        }
+
+        size_t push_back(T &&value)
+        {
+            size_t i=reserveSlots(1);
+            constructAt(i, std::move(value));
+            return i;
+        }
+
+        template<typename... Args>
+        size_t emplace_back(Args &&...args)
+        {
+            size_t i=reserveSlots(1);
+            constructAt(i, std::forward<Args>(args)...);
+            return i;
+        }
+
+        /**
+         * appends n default constructed elements in one reservation, so
+         * they are contiguous in index. returns the index of the first.
+         */
+        size_t grow_by(size_t n)
+        {
+            size_t first=reserveSlots(n);
+            constructRange(first, n);
+            return first;
+        }
+
+        /**
+         * appends n copies of value, returns the index of the first.
+         */
+        size_t grow_by(size_t n, const T &value)
+        {
+            size_t first=reserveSlots(n);
+            constructRange(first, n, value);
+            return first;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,388 @@
+#ifndef SJTU_COW_VECTOR_HPP
+#define SJTU_COW_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace sjtu
+{
+/**
+ * a vector whose copies share one reference-counted buffer until one of
+ * them is modified. copying and assigning are O(1) and copy no element;
+ * the first mutation of a shared buffer (any non-const member) gives the
+ * vector a private copy first ("detach"), after which it behaves like
+ * sjtu::vector.
+ *
+ * the count is atomic, so each thread may own a copy of the same buffer
+ * and read or modify its copy freely; one cow_vector object is still not
+ * safe to use from two threads at once.
+ *
+ * iterators are plain pointers. the non-const begin(), end(), operator[]
+ * and at() detach, since the caller may write through the result; copying
+ * the vector afterwards shares the buffer again, so a mutable pointer or
+ * reference taken before a copy must not be written through after it.
+ * use cbegin()/cend() and the const overloads for read-only access.
+ */
+    template<typename T>
+    class cow_vector
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "cow_vector does not handle over-aligned types");
+
+    public:
+        typedef T *iterator;
+        typedef const T *const_iterator;
+
+    private:
+        struct block
+        {
+            std::atomic<size_t> refs;
+            size_t size;
+            size_t capacity;
+        };
+
+        static const size_t HEADER=(sizeof(block)+alignof(T)-1)/alignof(T)*alignof(T);
+
+        block *b;
+
+        static T *elements(block *p)
+        {
+            return reinterpret_cast<T *>(reinterpret_cast<char *>(p)+HEADER);
+        }
+
+        static block *create(size_t capacity)
+        {
+            block *p=static_cast<block *>(::operator new(HEADER+capacity*sizeof(T)));
+            new(&p->refs) std::atomic<size_t>(1);
+            p->size=0;
+            p->capacity=capacity;
+            return p;
+        }
+
+        /**
+         * drops one reference, freeing the buffer with the last one.
+         */
+        static void release(block *p)
+        {
+            if(p==nullptr||p->refs.fetch_sub(1, std::memory_order_acq_rel)!=1) return;
+            T *e=elements(p);
+            for(size_t i=0;i<p->size;++i)
+                e[i].~T();
+            ::operator delete(p);
+        }
+
+        bool shared() const
+        {
+            return b!=nullptr&&b->refs.load(std::memory_order_acquire)!=1;
+        }
+
+        size_t grownCapacity(size_t required) const
+        {
+            size_t capacity=b==nullptr||b->capacity==0?10:b->capacity*2;
+            return capacity<required?required:capacity;
+        }
+
+        /**
+         * fills the empty block to with the elements of b: moved when b is
+         * ours alone, copied when other vectors still read it.
+         * to->size counts what is done, so a throwing copy can be undone.
+         */
+        void transfer(block *to)
+        {
+            if(b==nullptr) return;
+            T *src=elements(b), *dest=elements(to);
+            bool mine=!shared();
+            for(;to->size<b->size;++to->size)
+            {
+                if(mine) new(dest+to->size) T(std::move_if_noexcept(src[to->size]));
+                else new(dest+to->size) T(src[to->size]);
+            }
+        }
+
+        /**
+         * makes the buffer private and able to hold capacity elements.
+         */
+        void detach(size_t capacity)
+        {
+            if(b!=nullptr&&!shared()&&b->capacity>=capacity) return;
+            if(b!=nullptr&&b->capacity>capacity) capacity=b->capacity;
+            block *fresh=create(capacity);
+            try
+            {
+                transfer(fresh);
+            } catch(...)
+            {
+                release(fresh);
+                throw;
+            }
+            release(b);
+            b=fresh;
+        }
+
+        void detach()
+        {
+            if(shared()) detach(b->capacity);
+        }
+
+    public:
+        /**
+         * nothing is allocated until the first element arrives.
+         */
+        cow_vector() : b(nullptr)
+        {}
+
+        /**
+         * O(1): shares the buffer of other.
+         */
+        cow_vector(const cow_vector &other) : b(other.b)
+        {
+            if(b!=nullptr) b->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        cow_vector(cow_vector &&other) noexcept : b(other.b)
+        {
+            other.b=nullptr;
+        }
+
+        ~cow_vector()
+        {
+            release(b);
+        }
+
+        cow_vector &operator=(const cow_vector &other)
+        {
+            if(b==other.b) return *this;
+            if(other.b!=nullptr) other.b->refs.fetch_add(1, std::memory_order_relaxed);
+            release(b);
+            b=other.b;
+            return *this;
+        }
+
+        cow_vector &operator=(cow_vector &&other) noexcept
+        {
+            if(this==&other) return *this;
+            release(b);
+            b=other.b;
+            other.b=nullptr;
+            return *this;
+        }
+
+        /**
+         * access specified element with bounds checking
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        T &at(const size_t &pos)
+        {
+            if(pos>=size()) throw index_out_of_bound();
+            detach();
+            return elements(b)[pos];
+        }
+
+        const T &at(const size_t &pos) const
+        {
+            if(pos>=size()) throw index_out_of_bound();
+            return elements(b)[pos];
+        }
+
+        T &operator[](const size_t &pos)
+        {
+            return at(pos);
+        }
+
+        const T &operator[](const size_t &pos) const
+        {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        const T &front() const
+        {
+            if(empty()) throw container_is_empty();
+            return elements(b)[0];
+        }
+
+        const T &back() const
+        {
+            if(empty()) throw container_is_empty();
+            return elements(b)[b->size-1];
+        }
+
+        const T *data() const
+        {
+            return b==nullptr?nullptr:elements(b);
+        }
+
+        iterator begin()
+        {
+            detach();
+            return b==nullptr?nullptr:elements(b);
+        }
+
+        const_iterator cbegin() const
+        {
+            return data();
+        }
+
+        iterator end()
+        {
+            detach();
+            return b==nullptr?nullptr:elements(b)+b->size;
+        }
+
+        const_iterator cend() const
+        {
+            return b==nullptr?nullptr:elements(b)+b->size;
+        }
+
+        bool empty() const
+        {
+            return size()==0;
+        }
+
+        size_t size() const
+        {
+            return b==nullptr?0:b->size;
+        }
+
+        size_t capacity() const
+        {
+            return b==nullptr?0:b->capacity;
+        }
+
+        /**
+         * the number of vectors sharing this buffer, 0 without one.
+         */
+        size_t use_count() const
+        {
+            return b==nullptr?0:b->refs.load(std::memory_order_acquire);
+        }
+
+        /**
+         * a shared buffer is simply let go; a private one keeps its capacity.
+         */
+        void clear()
+        {
+            if(b==nullptr) return;
+            if(shared())
+            {
+                release(b);
+                b=nullptr;
+                return;
+            }
+            T *e=elements(b);
+            for(size_t i=0;i<b->size;++i)
+                e[i].~T();
+            b->size=0;
+        }
+
+        void reserve(size_t n)
+        {
+            if(n>capacity()) detach(n);
+        }
+
+        /**
+         * inserts value before index ind.
+         * throw index_out_of_bound if ind > size
+         */
+        iterator insert(const size_t &ind, const T &value)
+        {
+            if(ind>size()) throw index_out_of_bound();
+            //value may live in the buffer that detach is about to replace
+            T copy(value);
+            detach(size()==capacity()?grownCapacity(size()+1):size()+1);
+            T *e=elements(b);
+            if(ind==b->size) new(e+ind) T(std::move(copy));
+            else
+            {
+                new(e+b->size) T(std::move(e[b->size-1]));
+                for(size_t i=b->size-1;i>ind;--i)
+                    e[i]=std::move(e[i-1]);
+                e[ind]=std::move(copy);
+            }
+            b->size++;
+            return e+ind;
+        }
+
+        /**
+         * throw index_out_of_bound if ind >= size
+         */
+        iterator erase(const size_t &ind)
+        {
+            if(ind>=size()) throw index_out_of_bound();
+            detach();
+            T *e=elements(b);
+            for(size_t i=ind+1;i<b->size;++i)
+                e[i-1]=std::move(e[i]);
+            b->size--;
+            e[b->size].~T();
+            return e+ind;
+        }
+
+        void push_back(const T &value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        /**
+         * when the buffer must be replaced, the new element is built in the
+         * new buffer first, so args may refer to an element of this vector.
+         */
+        template<typename... Args>
+        T &emplace_back(Args &&...args)
+        {
+            size_t n=size();
+            if(b!=nullptr&&!shared()&&n<b->capacity)
+            {
+                T *p=new(elements(b)+n) T(std::forward<Args>(args)...);
+                b->size++;
+                return *p;
+            }
+            block *fresh=create(n<capacity()?capacity():grownCapacity(n+1));
+            T *p;
+            try
+            {
+                p=new(elements(fresh)+n) T(std::forward<Args>(args)...);
+            } catch(...)
+            {
+                ::operator delete(fresh);
+                throw;
+            }
+            try
+            {
+                transfer(fresh);
+            } catch(...)
+            {
+                p->~T();
+                release(fresh);
+                throw;
+            }
+            fresh->size=n+1;
+            release(b);
+            b=fresh;
+            return *p;
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_back()
+        {
+            if(empty()) throw container_is_empty();
+            detach();
+            b->size--;
+            elements(b)[b->size].~T();
+        }
+    };
+}
+
+#endif
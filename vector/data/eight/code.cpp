@@ -0,0 +1,224 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+class Fragile {
+public:
+	static int live;
+	static int copiesLeft;
+	int value;
+	Fragile(int v) : value(v) { ++live; }
+	Fragile(const Fragile &other) : value(other.value)
+	{
+		if (copiesLeft == 0) {
+			throw sjtu::runtime_error();
+		}
+		--copiesLeft;
+		++live;
+	}
+	Fragile(Fragile &&other) noexcept : value(other.value) { ++live; }
+	Fragile &operator=(const Fragile &other) { value = other.value; return *this; }
+	~Fragile() { --live; }
+};
+int Fragile::live = 0;
+int Fragile::copiesLeft = -1;
+
+std::ostream &operator<<(std::ostream &os, const Fragile &x)
+{
+	return os << x.value;
+}
+
+template<typename Vec>
+void Print(const Vec &v)
+{
+	std::cout << v.size() << ":";
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << " " << v[i];
+	}
+	std::cout << std::endl;
+}
+
+void TestInsertCount()
+{
+	std::cout << "Testing insert(pos, n, value)..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 8; ++i) {
+		v.push_back(i);
+	}
+	v.insert(v.begin() + 2, 3, -1);
+	Print(v);
+	v.insert(v.end(), 2, 9);
+	v.insert(v.begin(), 20, 5);
+	Print(v);
+	sjtu::vector<std::string> vs;
+	for (int i = 0; i < 6; ++i) {
+		vs.push_back(std::string(1, 'a' + i));
+	}
+	vs.insert(vs.begin() + 4, 5, vs[0]);
+	vs.insert(vs.begin() + 1, 1, "z");
+	Print(vs);
+}
+
+void TestInsertRange()
+{
+	std::cout << "Testing insert(pos, first, last)..." << std::endl;
+	sjtu::vector<long long> src;
+	for (long long i = 100; i < 110; ++i) {
+		src.push_back(i);
+	}
+	sjtu::vector<long long> v;
+	v.push_back(1);
+	v.push_back(2);
+	v.insert(v.begin() + 1, src.begin(), src.end());
+	v.insert(v.end(), src.cbegin() + 7, src.cend());
+	Print(v);
+	std::string words[] = {"one", "two", "three", "four"};
+	sjtu::vector<std::string> vs;
+	for (int i = 0; i < 12; ++i) {
+		vs.push_back(std::string(2, 'k' + i));
+	}
+	vs.insert(vs.begin() + 10, words, words + 4);
+	vs.insert(vs.begin() + 3, words + 1, words + 3);
+	Print(vs);
+}
+
+void TestEraseRange()
+{
+	std::cout << "Testing erase(first, last)..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 20; ++i) {
+		v.push_back(i);
+	}
+	sjtu::vector<int>::iterator it = v.erase(v.begin() + 3, v.begin() + 8);
+	std::cout << *it << std::endl;
+	v.erase(v.end() - 4, v.end());
+	v.erase(v.begin(), v.begin());
+	Print(v);
+	sjtu::vector<std::string> vs;
+	for (int i = 0; i < 10; ++i) {
+		vs.push_back(std::string(3, 'a' + i));
+	}
+	vs.erase(vs.begin() + 1, vs.begin() + 4);
+	Print(vs);
+	vs.erase(vs.begin(), vs.end());
+	std::cout << vs.size() << std::endl;
+}
+
+void TestAppend()
+{
+	std::cout << "Testing append..." << std::endl;
+	int raw[] = {7, 8, 9};
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.append(raw, 3);
+	}
+	v.append(v.data(), v.size());
+	std::cout << v.size() << " " << v[0] << " " << v[59] << std::endl;
+	sjtu::vector<std::string> vs;
+	vs.push_back("p");
+	vs.push_back("q");
+	vs.append(vs.data(), 2);
+	vs.append(vs.data() + 1, 3);
+	Print(vs);
+}
+
+void TestBulkFront()
+{
+	std::cout << "Testing bulk edits at the front of a large vector..." << std::endl;
+	sjtu::vector<long long> v;
+	for (long long i = 0; i < 1LL << 20; ++i) {
+		v.push_back(i);
+	}
+	sjtu::vector<long long> batch;
+	for (long long i = 0; i < 1LL << 11; ++i) {
+		batch.push_back(i);
+	}
+	v.insert(v.begin(), batch.begin(), batch.end());
+	v.erase(v.begin(), v.begin() + (1 << 10));
+	std::cout << v.size() << " " << v.front() << " " << v[1 << 10] << " " << v.back() << std::endl;
+}
+
+void TestInsertSinglePass()
+{
+	std::cout << "Testing insert from single-pass iterators..." << std::endl;
+	sjtu::vector<int> v;
+	v.push_back(1);
+	v.push_back(9);
+	std::istringstream in("2 3 4 5 6 7 8");
+	v.insert(v.begin() + 1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+	Print(v);
+	std::istringstream none("");
+	v.insert(v.end(), std::istream_iterator<int>(none), std::istream_iterator<int>());
+	Print(v);
+	sjtu::vector<std::string> w;
+	for (int i = 0; i < 10; ++i) {
+		w.push_back("w");
+	}
+	std::istringstream words("alpha beta gamma");
+	sjtu::vector<std::string>::iterator it = w.insert(w.begin() + 5, std::istream_iterator<std::string>(words), std::istream_iterator<std::string>());
+	std::cout << *it << " ";
+	Print(w);
+}
+
+void TestInsertThrows()
+{
+	std::cout << "Testing inserts that throw part-way..." << std::endl;
+	{
+		sjtu::vector<Fragile> v, src;
+		v.reserve(40);
+		for (int i = 0; i < 10; ++i) {
+			v.push_back(Fragile(i));
+		}
+		for (int i = 0; i < 6; ++i) {
+			src.push_back(Fragile(100 + i));
+		}
+		Fragile::copiesLeft = 3;
+		try {
+			v.insert(v.begin() + 2, 5, Fragile(-1));
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		Print(v);
+		Fragile::copiesLeft = 3;
+		try {
+			v.insert(v.begin() + 3, src.begin(), src.end());
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		Print(v);
+		Fragile::copiesLeft = 4;
+		try {
+			v.insert(v.begin() + 8, &src[0], &src[0] + src.size());
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		Print(v);
+		Fragile::copiesLeft = 20;
+		try {
+			v.insert(v.begin() + 1, 35, Fragile(7));
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		Print(v);
+		std::cout << Fragile::live << std::endl;
+		Fragile::copiesLeft = -1;
+		v.insert(v.begin() + 8, src.begin(), src.end());
+		Print(v);
+	}
+	std::cout << Fragile::live << std::endl;
+}
+
+int main()
+{
+	TestInsertCount();
+	TestInsertRange();
+	TestEraseRange();
+	TestAppend();
+	TestBulkFront();
+	TestInsertSinglePass();
+	TestInsertThrows();
+	return 0;
+}
@@ -0,0 +1,132 @@
+#include "vector.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <string>
+
+// the smallest allocator the standard model allows: no rebind, no traits
+template<class T>
+class arena_allocator {
+public:
+	typedef T value_type;
+	char *arena;
+	size_t *used;
+
+	arena_allocator(char *arena, size_t *used) : arena(arena), used(used) {}
+
+	template<class U>
+	arena_allocator(const arena_allocator<U> &other) : arena(other.arena), used(other.used) {}
+
+	T *allocate(size_t n) {
+		T *p = (T *)(arena + *used);
+		*used += (n * sizeof(T) + 15) / 16 * 16;
+		return p;
+	}
+
+	void deallocate(T *, size_t) {}
+
+	bool operator==(const arena_allocator &rhs) const {
+		return arena == rhs.arena;
+	}
+
+	bool operator!=(const arena_allocator &rhs) const {
+		return arena != rhs.arena;
+	}
+};
+
+void TestDefault()
+{
+	std::cout << "Testing the default allocator..." << std::endl;
+	sjtu::allocator<int> a;
+	int *p = a.allocate(100);
+	for (int i = 0; i < 100; ++i) {
+		p[i] = i;
+	}
+	std::cout << p[99] << std::endl;
+	a.deallocate(p, 100);
+	sjtu::allocator<std::string> b(a);
+	std::cout << (a == b) << " " << (a != b) << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	std::cout << v[999] << " " << (v.get_allocator() == a) << std::endl;
+}
+
+void TestCounting()
+{
+	std::cout << "Testing counting allocator..." << std::endl;
+	sjtu::allocation_stats stats;
+	typedef sjtu::vector<std::string, sjtu::double_growth, sjtu::counting_allocator<std::string> > counted;
+	{
+		counted v{sjtu::counting_allocator<std::string>(stats)};
+		std::cout << stats.allocations << " " << stats.bytes / sizeof(std::string) << std::endl;
+		for (int i = 0; i < 100; ++i) {
+			v.push_back(std::string(30, 'a' + i % 26));
+		}
+		// 10 -> 20 -> 40 -> 80 -> 160
+		std::cout << stats.allocations << " " << stats.live() << " " << stats.bytes / sizeof(std::string) << std::endl;
+		counted w(v);
+		std::cout << (w.get_allocator() == v.get_allocator()) << " " << stats.live() << std::endl;
+		v.shrink_to_fit();
+		std::cout << stats.bytes / sizeof(std::string) << std::endl;
+		counted x{sjtu::counting_allocator<std::string>(stats)};
+		x = std::move(w);
+		std::cout << x.size() << " " << w.size() << " " << stats.live() << std::endl;
+	}
+	std::cout << stats.live() << " " << stats.bytes << std::endl;
+	size_t before = sjtu::allocation_stats::global().allocations;
+	{
+		sjtu::vector<int, sjtu::double_growth, sjtu::counting_allocator<int> > v;
+		v.reserve(1000);
+	}
+	std::cout << sjtu::allocation_stats::global().allocations - before << " " << sjtu::allocation_stats::global().live() << std::endl;
+}
+
+void TestArena()
+{
+	std::cout << "Testing a user allocator..." << std::endl;
+	static char buffer[1 << 16];
+	size_t used = 0;
+	typedef sjtu::vector<long long, sjtu::double_growth, arena_allocator<long long> > arena_vector;
+	arena_vector v{arena_allocator<long long>(buffer, &used)};
+	for (long long i = 0; i < 1000; ++i) {
+		v.push_back(i * i);
+	}
+	std::cout << v[999] << " " << used << " " << ((char *)v.data() >= buffer && (char *)v.data() < buffer + sizeof(buffer)) << std::endl;
+	char other[1 << 14];
+	size_t otherUsed = 0;
+	arena_vector w{arena_allocator<long long>(other, &otherUsed)};
+	// different arenas and no propagation: elements move into w's arena
+	w = std::move(v);
+	std::cout << w.size() << " " << w[500] << " " << otherUsed << " " << ((char *)w.data() >= other) << std::endl;
+}
+
+void TestOverflow()
+{
+	std::cout << "Testing allocation sizes that overflow..." << std::endl;
+	sjtu::allocator<long long> a;
+	try {
+		a.allocate(SIZE_MAX / 8 + 2);
+	} catch (const std::bad_array_new_length &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	sjtu::allocation_stats stats;
+	sjtu::counting_allocator<long long> c(stats);
+	try {
+		c.allocate(SIZE_MAX / 4);
+	} catch (const std::bad_array_new_length &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	std::cout << stats.allocations << " " << stats.bytes << std::endl;
+}
+
+int main()
+{
+	TestDefault();
+	TestCounting();
+	TestArena();
+	TestOverflow();
+	return 0;
+}
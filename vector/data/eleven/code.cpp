@@ -0,0 +1,125 @@
+#include "parallel.hpp"
+
+#include <iostream>
+#include <string>
+
+void TestPool()
+{
+	std::cout << "Testing thread pool..." << std::endl;
+	sjtu::thread_pool pool(4);
+	std::atomic<size_t> sum(0);
+	pool.parallel_for(100000, 100, [&](size_t begin, size_t end) {
+		size_t local = 0;
+		for (size_t i = begin; i < end; ++i) {
+			local += i;
+		}
+		sum += local;
+	});
+	std::cout << pool.size() << " " << sum.load() << std::endl;
+	std::atomic<size_t> remaining(1000);
+	std::atomic<size_t> done(0);
+	for (int i = 0; i < 1000; ++i) {
+		pool.submit([&] {
+			done.fetch_add(1);
+			remaining.fetch_sub(1);
+		});
+	}
+	pool.wait(remaining);
+	std::cout << done.load() << std::endl;
+}
+
+void TestForEachTransform()
+{
+	std::cout << "Testing for_each and transform..." << std::endl;
+	sjtu::vector<long long> v;
+	for (long long i = 0; i < 1000000; ++i) {
+		v.push_back(i);
+	}
+	sjtu::for_each(sjtu::par, v.begin(), v.end(), [](long long &x) { x *= 3; });
+	sjtu::vector<double> d;
+	d.resize(v.size());
+	sjtu::transform(sjtu::par, v.begin(), v.end(), d.begin(), [](long long x) { return x / 2.0; });
+	sjtu::vector<double> e;
+	e.resize(v.size());
+	sjtu::transform(sjtu::seq, v.begin(), v.end(), e.begin(), [](long long x) { return x / 2.0; });
+	bool same = true;
+	for (size_t i = 0; i < d.size(); ++i) {
+		same = same && d[i] == e[i];
+	}
+	std::cout << v[999999] << " " << d[777] << " " << (same ? "same" : "different") << std::endl;
+}
+
+void TestReduceScan()
+{
+	std::cout << "Testing reduce and inclusive_scan..." << std::endl;
+	sjtu::vector<long long> v;
+	for (long long i = 1; i <= 3000000; ++i) {
+		v.push_back(i % 1000);
+	}
+	std::cout << sjtu::reduce(sjtu::par, v.begin(), v.end(), 0LL) << " "
+	          << sjtu::reduce(sjtu::seq, v.begin(), v.end(), 0LL) << " "
+	          << sjtu::reduce(sjtu::par, v.begin(), v.end(), 0LL, [](long long a, long long b) { return a > b ? a : b; }) << std::endl;
+	sjtu::vector<long long> p, s;
+	p.resize(v.size());
+	s.resize(v.size());
+	sjtu::inclusive_scan(sjtu::par, v.begin(), v.end(), p.begin());
+	sjtu::inclusive_scan(sjtu::seq, v.begin(), v.end(), s.begin());
+	bool same = true;
+	for (size_t i = 0; i < p.size(); ++i) {
+		same = same && p[i] == s[i];
+	}
+	std::cout << p[0] << " " << p[12345] << " " << p.back() << " " << (same ? "same" : "different") << std::endl;
+	sjtu::vector<std::string> w;
+	for (int i = 0; i < 5; ++i) {
+		w.push_back(std::string(1, 'a' + i));
+	}
+	sjtu::inclusive_scan(sjtu::par, w.begin(), w.end(), w.begin());
+	std::cout << w.back() << " " << sjtu::reduce(sjtu::par, w.begin(), w.end(), std::string(">")) << std::endl;
+}
+
+struct Item {
+	int key, order;
+};
+
+void TestSort()
+{
+	std::cout << "Testing parallel merge sort..." << std::endl;
+	sjtu::vector<int> v;
+	unsigned int seed = 12345;
+	for (int i = 0; i < 2000000; ++i) {
+		seed = seed * 1103515245u + 12345u;
+		v.push_back(int(seed >> 8) % 1000000);
+	}
+	sjtu::vector<int> w(v);
+	sjtu::sort(sjtu::par, v.begin(), v.end());
+	sjtu::sort(sjtu::seq, w.begin(), w.end());
+	bool sorted = true, same = true;
+	for (size_t i = 1; i < v.size(); ++i) {
+		sorted = sorted && v[i - 1] <= v[i];
+	}
+	for (size_t i = 0; i < v.size(); ++i) {
+		same = same && v[i] == w[i];
+	}
+	std::cout << (sorted ? "sorted" : "unsorted") << " " << (same ? "same" : "different") << " " << v.front() << " " << v.back() << std::endl;
+	sjtu::vector<Item> items;
+	for (int i = 0; i < 100000; ++i) {
+		items.push_back(Item{i % 10, i});
+	}
+	sjtu::sort(sjtu::par, items.begin(), items.end(), [](const Item &a, const Item &b) { return a.key > b.key; });
+	bool stable = true;
+	for (size_t i = 1; i < items.size(); ++i) {
+		if (items[i - 1].key == items[i].key) {
+			stable = stable && items[i - 1].order < items[i].order;
+		}
+	}
+	std::cout << items[0].key << " " << items[0].order << " " << (stable ? "stable" : "unstable") << std::endl;
+}
+
+int main()
+{
+	TestPool();
+	TestForEachTransform();
+	TestReduceScan();
+	TestSort();
+	return 0;
+}
@@ -0,0 +1,55 @@
+#define SJTU_HUGE_PAGES
+#define SJTU_HUGE_PAGE_THRESHOLD (size_t(1) << 20)
+#define SJTU_PREFAULT
+#include "vector.hpp"
+
+#include <iostream>
+
+// the kernel may refuse MADV_HUGEPAGE, so the counter is only checked
+// against the buffers this test holds, not against an absolute value
+
+void TestSmall()
+{
+	std::cout << "Testing small buffers stay on the heap..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.back() << " " << sjtu::huge_pages::bytes() << std::endl;
+}
+
+void TestLarge()
+{
+	std::cout << "Testing large buffers..." << std::endl;
+	{
+		sjtu::vector<long long> v;
+		v.reserve(1 << 20);
+		size_t held = sjtu::huge_pages::bytes();
+		std::cout << (held == 0 || held >= (size_t(8) << 20)) << std::endl;
+		for (long long i = 0; i < (1 << 21); ++i) {
+			v.push_back(i * 3);
+		}
+		long long sum = 0;
+		for (size_t i = 0; i < v.size(); ++i) {
+			sum += v[i];
+		}
+		std::cout << v.size() << " " << sum << " " << v[12345] << std::endl;
+		std::cout << (reinterpret_cast<size_t>(v.data()) % sjtu::huge_pages::HUGE_PAGE) << std::endl;
+
+		sjtu::vector<long long> w(v);
+		std::cout << w[(1 << 21) - 1] << std::endl;
+		v.clear();
+		v.shrink_to_fit();
+		w.erase(w.begin() + 10, w.end());
+		w.shrink_to_fit();
+		std::cout << w.size() << " " << w.back() << " " << sjtu::huge_pages::bytes() << std::endl;
+	}
+	std::cout << sjtu::huge_pages::bytes() << std::endl;
+}
+
+int main()
+{
+	TestSmall();
+	TestLarge();
+	return 0;
+}
@@ -0,0 +1,174 @@
+#include "vector.hpp"
+
+#include "class-matrix.hpp"
+#include "class-bint.hpp"
+
+#include <iostream>
+#include <string>
+
+class Tracked {
+public:
+	static int copies;
+	int value;
+	Tracked(int v) : value(v) {}
+	Tracked(int a, int b) : value(a * b) {}
+	Tracked(const Tracked &other) : value(other.value) { ++copies; }
+	Tracked(Tracked &&other) noexcept : value(other.value) { other.value = -1; }
+	Tracked &operator=(const Tracked &other) { value = other.value; ++copies; return *this; }
+	Tracked &operator=(Tracked &&other) noexcept { value = other.value; other.value = -1; return *this; }
+};
+int Tracked::copies = 0;
+
+class Fragile {
+public:
+	static int live;
+	static int copiesLeft;
+	int value;
+	Fragile(int v) : value(v) { ++live; }
+	Fragile(const Fragile &other) : value(other.value)
+	{
+		if (copiesLeft == 0) {
+			throw sjtu::runtime_error();
+		}
+		--copiesLeft;
+		++live;
+	}
+	Fragile &operator=(const Fragile &other) { value = other.value; return *this; }
+	~Fragile() { --live; }
+};
+int Fragile::live = 0;
+int Fragile::copiesLeft = -1;
+
+void TestGrowthDoesNotCopy()
+{
+	std::cout << "Testing growth relocates instead of copying..." << std::endl;
+	sjtu::vector<Tracked> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(Tracked(i));
+	}
+	v.insert(v.begin() + 10, Tracked(-10));
+	v.erase(v.begin() + 20);
+	std::cout << v.size() << " " << v[10].value << " " << v[20].value << " " << v.back().value << std::endl;
+	std::cout << "copies: " << Tracked::copies << std::endl;
+}
+
+void TestEmplace()
+{
+	std::cout << "Testing emplace_back and emplace..." << std::endl;
+	sjtu::vector<Tracked> v;
+	for (int i = 1; i <= 12; ++i) {
+		v.emplace_back(i, 10);
+	}
+	v.emplace(v.begin(), 7, 7);
+	v.emplace(v.begin() + 5, 3, 3);
+	v.emplace_back(v[0]);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i].value << " ";
+	}
+	std::cout << std::endl;
+	std::cout << "copies: " << Tracked::copies << std::endl;
+}
+
+void TestSelfReference()
+{
+	std::cout << "Testing insert of an element of the same vector..." << std::endl;
+	sjtu::vector<std::string> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::string(20, 'a' + i));
+	}
+	v.push_back(v[3]);
+	v.insert(v.begin(), v[5]);
+	v.insert(v.begin() + 2, v.back());
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i][0];
+	}
+	std::cout << std::endl;
+}
+
+void TestMoveConstructAndAssign()
+{
+	std::cout << "Testing move constructor and move assignment..." << std::endl;
+	sjtu::vector<Diamond::Matrix<Util::Bint>> v;
+	for (int i = 1; i <= 100; ++i) {
+		v.push_back(Diamond::Matrix<Util::Bint>(2, 2, Util::Bint(i * 12345)));
+	}
+	sjtu::vector<Diamond::Matrix<Util::Bint>> moved(std::move(v));
+	std::cout << moved.size() << " " << v.size() << " " << moved[99][0][0] << std::endl;
+	sjtu::vector<Diamond::Matrix<Util::Bint>> assigned;
+	assigned.push_back(Diamond::Matrix<Util::Bint>(1, 1, Util::Bint(1)));
+	assigned = std::move(moved);
+	std::cout << assigned.size() << " " << moved.size() << " " << assigned[0][1][1] << std::endl;
+	moved.push_back(assigned.back());
+	moved.emplace_back(3, 3, Util::Bint(42));
+	std::cout << moved.size() << " " << moved[0][0][0] << " " << moved[1][2][2] << std::endl;
+}
+
+void PrintFragile(const sjtu::vector<Fragile> &v)
+{
+	int sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i].value;
+	}
+	std::cout << v.size() << " " << v.capacity() << " " << sum << " " << Fragile::live << std::endl;
+}
+
+void TestGrowthThrows()
+{
+	std::cout << "Testing growth that throws part-way..." << std::endl;
+	{
+		sjtu::vector<Fragile> v;
+		for (int i = 0; i < 10; ++i) {
+			v.push_back(Fragile(i));
+		}
+		PrintFragile(v);
+		Fragile::copiesLeft = 5;
+		try {
+			v.push_back(Fragile(10));
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		PrintFragile(v);
+		Fragile::copiesLeft = 3;
+		try {
+			v.reserve(100);
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		PrintFragile(v);
+		Fragile::copiesLeft = 25;
+		try {
+			v.resize(30, Fragile(7));
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		PrintFragile(v);
+		Fragile::copiesLeft = 2;
+		try {
+			v.append(&v[0], 5);
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		PrintFragile(v);
+		Fragile::copiesLeft = 7;
+		try {
+			v.insert(v.begin() + 3, Fragile(-1));
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		PrintFragile(v);
+		Fragile::copiesLeft = -1;
+		v.push_back(Fragile(10));
+		PrintFragile(v);
+	}
+	std::cout << Fragile::live << std::endl;
+}
+
+int main()
+{
+	TestGrowthDoesNotCopy();
+	TestEmplace();
+	TestSelfReference();
+	TestMoveConstructAndAssign();
+	TestGrowthThrows();
+	return 0;
+}
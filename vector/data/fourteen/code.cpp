@@ -0,0 +1,79 @@
+#include "stable_vector.hpp"
+
+#include "class-integer.hpp"
+
+#include <iostream>
+#include <string>
+
+void TestStableAddresses()
+{
+	std::cout << "Testing addresses survive growth..." << std::endl;
+	sjtu::stable_vector<long long> v;
+	std::cout << v.capacity() << std::endl;
+	v.push_back(0);
+	long long *first = &v[0];
+	v.push_back(1);
+	long long *second = &v[1];
+	for (long long i = 2; i < 1000000; ++i) {
+		v.push_back(i);
+	}
+	std::cout << (first == &v[0] && second == &v[1] ? "stable" : "moved") << " " << v.size() << " " << v.capacity() << std::endl;
+	long long sum = 0;
+	for (sjtu::stable_vector<long long>::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		sum += *it;
+	}
+	std::cout << sum << " " << v[7] << " " << v[8] << " " << v[123456] << " " << v.back() << std::endl;
+}
+
+void TestModifiers()
+{
+	std::cout << "Testing insert and erase..." << std::endl;
+	sjtu::stable_vector<std::string> v;
+	for (int i = 0; i < 20; ++i) {
+		v.push_back(std::string(1, 'a' + i));
+	}
+	v.insert(v.begin() + 3, "X");
+	v.insert(0, v[5]);
+	v.erase(v.begin() + 10);
+	v.erase(v.size() - 1);
+	v.emplace_back(3, 'z');
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	try {
+		v.at(v.size());
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestCopyAndShrink()
+{
+	std::cout << "Testing copy, move, clear and shrink_to_fit..." << std::endl;
+	sjtu::stable_vector<Integer> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(Integer(i));
+	}
+	sjtu::stable_vector<Integer> c(v);
+	sjtu::stable_vector<Integer> m(std::move(v));
+	std::cout << c.size() << " " << m.size() << " " << v.size() << std::endl;
+	while (m.size() > 10) {
+		m.pop_back();
+	}
+	m.shrink_to_fit();
+	std::cout << m.size() << " " << m.capacity() << std::endl;
+	c.clear();
+	std::cout << c.size() << " " << c.capacity() << std::endl;
+	c = m;
+	v = std::move(c);
+	std::cout << v.size() << " " << c.size() << std::endl;
+}
+
+int main()
+{
+	TestStableAddresses();
+	TestModifiers();
+	TestCopyAndShrink();
+	return 0;
+}
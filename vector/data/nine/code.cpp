@@ -0,0 +1,182 @@
+#include "small_vector.hpp"
+
+#include "class-integer.hpp"
+#include "class-bint.hpp"
+
+#include <iostream>
+#include <string>
+
+template<typename Vec>
+void Print(const Vec &v)
+{
+	std::cout << v.size() << (v.is_inline() ? " inline:" : " heap:");
+	for (typename Vec::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		std::cout << " " << *it;
+	}
+	std::cout << std::endl;
+}
+
+void TestInline()
+{
+	std::cout << "Testing inline storage..." << std::endl;
+	sjtu::small_vector<int, 8> v;
+	for (int i = 0; i < 8; ++i) {
+		v.push_back(i * i);
+	}
+	Print(v);
+	v.insert(v.begin() + 2, -1);
+	Print(v);
+	v.erase(v.begin());
+	v.erase(v.begin());
+	v.shrink_to_fit();
+	Print(v);
+	try {
+		v.at(100);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestCopyAndMove()
+{
+	std::cout << "Testing copy and move..." << std::endl;
+	sjtu::small_vector<std::string, 4> a;
+	a.push_back("alpha");
+	a.push_back("beta");
+	sjtu::small_vector<std::string, 4> b(a);
+	b.emplace_back(3, 'c');
+	sjtu::small_vector<std::string, 4> c(std::move(b));
+	Print(a);
+	Print(b);
+	Print(c);
+	for (int i = 0; i < 6; ++i) {
+		c.push_back(c[i]);
+	}
+	sjtu::small_vector<std::string, 4> d;
+	d = c;
+	a = std::move(c);
+	Print(a);
+	Print(c);
+	Print(d);
+	d = b;
+	Print(d);
+}
+
+class Fixed {
+public:
+	const int id;
+	Fixed(int id) : id(id) {}
+	Fixed(const Fixed &other) : id(other.id) {}
+	Fixed &operator=(const Fixed &) = delete;
+};
+
+std::ostream &operator<<(std::ostream &os, const Fixed &x)
+{
+	return os << x.id;
+}
+
+class Fragile {
+public:
+	static int live;
+	static int copiesLeft;
+	int value;
+	Fragile(int v) : value(v) { ++live; }
+	Fragile(const Fragile &other) : value(other.value)
+	{
+		if (copiesLeft == 0) {
+			throw sjtu::runtime_error();
+		}
+		--copiesLeft;
+		++live;
+	}
+	Fragile &operator=(const Fragile &other) { value = other.value; return *this; }
+	~Fragile() { --live; }
+};
+int Fragile::live = 0;
+int Fragile::copiesLeft = -1;
+
+std::ostream &operator<<(std::ostream &os, const Fragile &x)
+{
+	return os << x.value;
+}
+
+void TestGrowthThrows()
+{
+	std::cout << "Testing growth that throws part-way..." << std::endl;
+	{
+		sjtu::small_vector<Fragile, 4> v;
+		for (int i = 0; i < 4; ++i) {
+			v.push_back(Fragile(i));
+		}
+		Fragile::copiesLeft = 3;
+		try {
+			v.push_back(Fragile(4));
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		Print(v);
+		Fragile::copiesLeft = -1;
+		for (int i = 4; i < 8; ++i) {
+			v.push_back(Fragile(i));
+		}
+		Fragile::copiesLeft = 5;
+		try {
+			v.insert(v.begin() + 2, Fragile(-1));
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		Print(v);
+		Fragile::copiesLeft = 2;
+		try {
+			v.reserve(100);
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		Fragile::copiesLeft = 6;
+		try {
+			sjtu::small_vector<Fragile, 4> w(v);
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		Print(v);
+		std::cout << Fragile::live << std::endl;
+		Fragile::copiesLeft = -1;
+	}
+	std::cout << Fragile::live << std::endl;
+}
+
+void TestObjects()
+{
+	std::cout << "Testing elements without default constructor..." << std::endl;
+	sjtu::small_vector<Integer, 3> vi;
+	for (int i = 0; i < 100; ++i) {
+		vi.push_back(Integer(i));
+	}
+	std::cout << vi.size() << std::endl;
+	sjtu::small_vector<Util::Bint, 2> vb;
+	for (int i = 1; i <= 10; ++i) {
+		vb.insert(vb.begin(), Util::Bint(i) * Util::Bint(987654321));
+	}
+	while (vb.size() > 2) {
+		vb.pop_back();
+	}
+	vb.shrink_to_fit();
+	Print(vb);
+	sjtu::small_vector<Fixed, 4> vf;
+	for (int i = 0; i < 3; ++i) {
+		vf.push_back(Fixed(i));
+	}
+	vf.insert(vf.begin() + 1, Fixed(10));
+	vf.insert(vf.begin(), Fixed(20));
+	vf.erase(vf.begin() + 2);
+	Print(vf);
+}
+
+int main()
+{
+	TestInline();
+	TestCopyAndMove();
+	TestObjects();
+	TestGrowthThrows();
+	return 0;
+}
@@ -0,0 +1,118 @@
+#include "cow_vector.hpp"
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+class Tracked {
+public:
+	static int copies;
+	int value;
+	Tracked(int v) : value(v) {}
+	Tracked(const Tracked &other) : value(other.value) { ++copies; }
+	Tracked(Tracked &&other) noexcept : value(other.value) { other.value = -1; }
+	Tracked &operator=(const Tracked &other) { value = other.value; ++copies; return *this; }
+	Tracked &operator=(Tracked &&other) noexcept { value = other.value; other.value = -1; return *this; }
+};
+int Tracked::copies = 0;
+
+long long Stage(sjtu::cow_vector<Tracked> v)
+{
+	long long sum = 0;
+	for (sjtu::cow_vector<Tracked>::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		sum += it->value;
+	}
+	return sum;
+}
+
+void TestSharing()
+{
+	std::cout << "Testing copies share the buffer..." << std::endl;
+	sjtu::cow_vector<Tracked> v;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(Tracked(i));
+	}
+	Tracked::copies = 0;
+	sjtu::cow_vector<Tracked> a(v), b;
+	b = a;
+	std::cout << v.use_count() << std::endl;
+	std::cout << Stage(v) + Stage(a) + Stage(b) << " " << Tracked::copies << std::endl;
+	std::cout << (a.data() == v.data()) << " " << a[10].value << std::endl;
+	// the non-const operator[] above detached a
+	std::cout << (a.data() == v.data()) << " " << a.use_count() << " " << v.use_count() << " " << Tracked::copies << std::endl;
+	a[10].value = -10;
+	const sjtu::cow_vector<Tracked> &cv = v;
+	std::cout << cv[10].value << " " << a[10].value << " " << b[10].value << std::endl;
+	Tracked::copies = 0;
+	b.push_back(Tracked(1000));
+	std::cout << b.size() << " " << v.size() << " " << Tracked::copies << " " << v.use_count() << std::endl;
+	b.erase(0);
+	b.insert(0, b[999]);
+	std::cout << b.front().value << " " << b.back().value << " " << b.size() << std::endl;
+}
+
+void TestMutations()
+{
+	std::cout << "Testing detach on each mutation..." << std::endl;
+	sjtu::cow_vector<std::string> v;
+	std::cout << v.size() << " " << v.capacity() << " " << v.use_count() << std::endl;
+	for (int i = 0; i < 20; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	sjtu::cow_vector<std::string> c1(v), c2(v), c3(v), c4(v), c5(v);
+	c1.pop_back();
+	c2.clear();
+	c3.reserve(1000);
+	c4.emplace_back(c4.cbegin()[5]);
+	*c5.begin() = "first";
+	std::cout << v.size() << " " << c1.size() << " " << c2.size() << " " << c3.capacity() << " " << c4.back() << " " << c5.front() << " " << v.front() << std::endl;
+	std::cout << v.use_count() << " " << c3.use_count() << std::endl;
+	try {
+		v.at(20);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	sjtu::cow_vector<std::string> moved(std::move(c3));
+	std::cout << moved.size() << " " << c3.size() << " " << moved.use_count() << std::endl;
+}
+
+void TestThreads()
+{
+	std::cout << "Testing snapshots in reader threads..." << std::endl;
+	sjtu::cow_vector<long long> v;
+	for (long long i = 0; i < 100000; ++i) {
+		v.push_back(i);
+	}
+	long long sums[4];
+	std::thread readers[4];
+	for (int t = 0; t < 4; ++t) {
+		sjtu::cow_vector<long long> snapshot(v);
+		readers[t] = std::thread([snapshot, &sums, t]() mutable {
+			long long sum = 0;
+			for (size_t i = 0; i < snapshot.size(); ++i) {
+				sum += static_cast<const sjtu::cow_vector<long long> &>(snapshot)[i];
+			}
+			// a writing reader detaches without disturbing the others
+			if (t == 0) {
+				snapshot[0] = 1000000;
+				sum += snapshot[0];
+			}
+			sums[t] = sum;
+		});
+	}
+	for (int i = 0; i < 1000; ++i) {
+		v[i] = -1;
+	}
+	for (int t = 0; t < 4; ++t) {
+		readers[t].join();
+	}
+	std::cout << sums[0] << " " << sums[1] << " " << sums[2] << " " << sums[3] << " " << v[999] << " " << v.use_count() << std::endl;
+}
+
+int main()
+{
+	TestSharing();
+	TestMutations();
+	TestThreads();
+	return 0;
+}
@@ -0,0 +1,62 @@
+#include "vector.hpp"
+
+#include "class-bint.hpp"
+
+#include <iostream>
+
+// Bint only owns a heap array, so moving its bytes is a valid move.
+namespace sjtu {
+template<>
+struct is_trivially_relocatable<Util::Bint> : std::true_type {};
+}
+
+struct Point {
+	int x, y;
+};
+
+void TestTrivial()
+{
+	std::cout << "Testing trivially copyable elements..." << std::endl;
+	sjtu::vector<Point> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(Point{i, -i});
+	}
+	for (int i = 0; i < 50; ++i) {
+		v.insert(v.begin(), Point{1000 + i, 0});
+	}
+	for (int i = 0; i < 25; ++i) {
+		v.erase(v.begin() + 10);
+	}
+	sjtu::vector<Point> copy(v);
+	v.clear();
+	std::cout << copy.size() << " " << copy[0].x << " " << copy[10].x << " " << copy[30].x << " " << copy.back().y << std::endl;
+}
+
+void TestRelocatableBint()
+{
+	std::cout << "Testing user-declared relocatable elements..." << std::endl;
+	sjtu::vector<Util::Bint> v;
+	for (int i = 1; i <= 200; ++i) {
+		v.push_back(Util::Bint(i) * Util::Bint(1000000007));
+	}
+	for (int i = 0; i < 20; ++i) {
+		v.insert(v.begin() + i * 3, Util::Bint(-i));
+	}
+	for (int i = 0; i < 30; ++i) {
+		v.erase(v.begin());
+	}
+	v.insert(v.begin() + 5, v.back());
+	sjtu::vector<Util::Bint> copy;
+	copy = v;
+	for (size_t i = 0; i < 8; ++i) {
+		std::cout << copy[i] << " ";
+	}
+	std::cout << std::endl << copy.size() << " " << copy.back() << std::endl;
+}
+
+int main()
+{
+	TestTrivial();
+	TestRelocatableBint();
+	return 0;
+}
@@ -0,0 +1,118 @@
+#include "gap_vector.hpp"
+
+#include <iostream>
+#include <string>
+
+#include <vector>
+
+void TestFrontInsert()
+{
+	std::cout << "Testing clustered front inserts..." << std::endl;
+	sjtu::gap_vector<long long> v;
+	for (long long i = 0; i < 1LL << 20; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.back() << std::endl;
+	for (long long i = 0; i < 1LL << 11; ++i) {
+		v.insert(v.begin(), i);
+	}
+	long long sum = 0;
+	for (size_t i = 0; i < 1LL << 10; ++i) {
+		sum += v.front();
+		v.erase(v.begin());
+	}
+	std::cout << sum << " " << v.front() << " " << v.size() << " " << v.gap_position() << std::endl;
+}
+
+template<typename T, typename Make>
+bool Replay(Make make)
+{
+	sjtu::gap_vector<T> v;
+	std::vector<T> ref;
+	unsigned seed = 12345;
+	size_t cursor = 0;
+	for (int step = 0; step < 20000; ++step) {
+		seed = seed * 1103515245 + 12345;
+		unsigned r = (seed >> 8) % 100;
+		if (r < 5) {
+			cursor = ref.empty() ? 0 : (seed >> 4) % (ref.size() + 1);
+		} else if (r < 60) {
+			v.insert(v.begin() + cursor, make(step));
+			ref.insert(ref.begin() + cursor, make(step));
+			cursor++;
+		} else if (r < 85) {
+			if (cursor > 0) {
+				cursor--;
+				v.erase(cursor);
+				ref.erase(ref.begin() + cursor);
+			}
+		} else if (r < 95) {
+			v.push_back(make(step));
+			ref.push_back(make(step));
+		} else if (!ref.empty()) {
+			v.pop_back();
+			ref.pop_back();
+			if (cursor > ref.size()) {
+				cursor = ref.size();
+			}
+		}
+	}
+	if (v.size() != ref.size()) {
+		return false;
+	}
+	size_t i = 0;
+	for (typename sjtu::gap_vector<T>::const_iterator it = v.cbegin(); it != v.cend(); ++it, ++i) {
+		if (!(*it == ref[i])) {
+			return false;
+		}
+	}
+	sjtu::gap_vector<T> copy(v);
+	sjtu::gap_vector<T> moved(std::move(copy));
+	moved.shrink_to_fit();
+	for (i = 0; i < ref.size(); ++i) {
+		if (!(moved[i] == ref[i])) {
+			return false;
+		}
+	}
+	return moved.capacity() == ref.size() && copy.size() == 0;
+}
+
+void TestReplay()
+{
+	std::cout << "Testing random cursor edits against std::vector..." << std::endl;
+	std::cout << Replay<int>([](int x) { return x; }) << std::endl;
+	std::cout << Replay<std::string>([](int x) { return std::string(x % 40, 'a' + x % 26); }) << std::endl;
+}
+
+void TestMisc()
+{
+	std::cout << "Testing exceptions and self insertion..." << std::endl;
+	sjtu::gap_vector<std::string> v;
+	try {
+		v.front();
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::string(20, 'a' + i));
+	}
+	// the buffer is full, the argument must survive the reallocation
+	v.insert(v.begin() + 3, v[9]);
+	v.emplace(v.begin(), 3, 'z');
+	std::cout << v[0] << " " << v[4] << " " << v.size() << std::endl;
+	try {
+		v.erase(v.size());
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	v.clear();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+}
+
+int main()
+{
+	TestFrontInsert();
+	TestReplay();
+	TestMisc();
+	return 0;
+}
@@ -0,0 +1,172 @@
+#include "vector.hpp"
+
+#include "class-integer.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+class Fragile {
+public:
+	static int live;
+	static int copiesLeft;
+	int value;
+	Fragile(int v) : value(v) { ++live; }
+	Fragile(const Fragile &other) : value(other.value)
+	{
+		if (copiesLeft == 0) {
+			throw sjtu::runtime_error();
+		}
+		--copiesLeft;
+		++live;
+	}
+	Fragile &operator=(const Fragile &other) { value = other.value; return *this; }
+	~Fragile() { --live; }
+};
+int Fragile::live = 0;
+int Fragile::copiesLeft = -1;
+
+void TestReserve()
+{
+	std::cout << "Testing reserve and capacity..." << std::endl;
+	sjtu::vector<long long> v;
+	v.reserve(1000);
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	const long long *p = v.data();
+	for (long long i = 0; i < 1000; ++i) {
+		v.push_back(i * i);
+	}
+	std::cout << (p == v.data() ? "no reallocation" : "reallocated") << std::endl;
+	v.reserve(10);
+	std::cout << v.capacity() << " " << v[999] << std::endl;
+	sjtu::vector<long long> w;
+	try {
+		w.reserve(SIZE_MAX / 8 + 2);
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		w.resize(SIZE_MAX / 8 + 2);
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	w.push_back(1);
+	std::cout << w.size() << " " << w.capacity() << " " << w[0] << std::endl;
+}
+
+void TestResize()
+{
+	std::cout << "Testing resize..." << std::endl;
+	sjtu::vector<int> v;
+	v.resize(5);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	v.resize(30, 7);
+	v.resize(8);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	sjtu::vector<std::string> vs;
+	vs.push_back("x");
+	vs.resize(12, vs[0]);
+	std::cout << vs.size() << " " << vs[11] << std::endl;
+	sjtu::vector<Integer> vi;
+	vi.resize(3, Integer(9));
+	std::cout << vi.size() << std::endl;
+}
+
+void TestShrinkAndClear()
+{
+	std::cout << "Testing clear and shrink_to_fit..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(i);
+	}
+	size_t cap = v.capacity();
+	v.clear();
+	std::cout << v.size() << " " << (v.capacity() == cap ? "capacity kept" : "capacity lost") << std::endl;
+	for (int i = 0; i < 3; ++i) {
+		v.push_back(i);
+	}
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	v.clear();
+	v.shrink_to_fit();
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	v.push_back(42);
+	std::cout << v.back() << " " << v.capacity() << std::endl;
+}
+
+void TestAssignThrows()
+{
+	std::cout << "Testing copies that throw part-way..." << std::endl;
+	{
+		sjtu::vector<Fragile> a, b;
+		for (int i = 0; i < 20; ++i) {
+			a.push_back(Fragile(i));
+		}
+		for (int i = 0; i < 3; ++i) {
+			b.push_back(Fragile(100));
+		}
+		Fragile::copiesLeft = 10;
+		try {
+			b = a;
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		std::cout << b.size() << " " << b[2].value << " " << Fragile::live << std::endl;
+		Fragile::copiesLeft = 10;
+		try {
+			sjtu::vector<Fragile> c(a);
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		std::cout << Fragile::live << std::endl;
+		Fragile::copiesLeft = -1;
+		b = a;
+		b.pop_back();
+		Fragile::copiesLeft = 5;
+		try {
+			a = b;
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		std::cout << a.size() << " " << b.size() << " " << Fragile::live << std::endl;
+		Fragile::copiesLeft = -1;
+		a = b;
+		std::cout << a.size() << " " << a[18].value << " " << Fragile::live << std::endl;
+	}
+	std::cout << Fragile::live << std::endl;
+}
+
+template<typename Growth>
+void TestGrowth(const char *name)
+{
+	sjtu::vector<int, Growth> v;
+	int reallocations = 0;
+	size_t cap = v.capacity();
+	for (int i = 0; i < 5000; ++i) {
+		v.push_back(i);
+		if (v.capacity() != cap) {
+			++reallocations;
+			cap = v.capacity();
+		}
+	}
+	std::cout << name << ": " << reallocations << " reallocations, capacity " << v.capacity() << ", back " << v.back() << std::endl;
+}
+
+int main()
+{
+	TestReserve();
+	TestResize();
+	TestShrinkAndClear();
+	TestAssignThrows();
+	std::cout << "Testing growth policies..." << std::endl;
+	TestGrowth<sjtu::double_growth>("double");
+	TestGrowth<sjtu::half_growth>("half");
+	TestGrowth<sjtu::fixed_growth<1024>>("fixed");
+	return 0;
+}
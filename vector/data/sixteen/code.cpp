@@ -0,0 +1,185 @@
+#include "concurrent_vector.hpp"
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// run with "bench" as the argument to time concurrent_vector against a mutex-wrapped sjtu::vector
+
+const int THREADS = 8;
+const int PER_THREAD = 200000;
+
+void TestBasic()
+{
+	std::cout << "Testing push_back and grow_by..." << std::endl;
+	sjtu::concurrent_vector<int> v;
+	std::cout << v.size() << " " << v.capacity() << " " << v.empty() << std::endl;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(i);
+	}
+	size_t first = v.grow_by(50, 7);
+	size_t zero = v.grow_by(10);
+	int *p = &v[0];
+	for (int i = 0; i < 100000; ++i) {
+		v.emplace_back(i);
+	}
+	std::cout << first << " " << zero << " " << v[first + 49] << " " << v[zero] << std::endl;
+	std::cout << v.size() << " " << v[160 + 99999] << " " << (p == &v[0]) << std::endl;
+	try {
+		v.at(v.size());
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	sjtu::concurrent_vector<int> w(v);
+	v.clear();
+	std::cout << v.size() << " " << w.size() << " " << w[123] << std::endl;
+	v.reserve(1000);
+	std::cout << v.capacity() << std::endl;
+}
+
+struct Fragile {
+	static int live;
+	static int copiesLeft;
+	int value;
+	Fragile() noexcept : value(0) { live++; }
+	Fragile(int v) : value(v) { live++; }
+	Fragile(const Fragile &other) : value(other.value)
+	{
+		if (copiesLeft-- == 0) {
+			throw 1;
+		}
+		live++;
+	}
+	~Fragile() { live--; }
+};
+
+int Fragile::live = 0;
+int Fragile::copiesLeft = -1;
+
+void TestThrowing()
+{
+	std::cout << "Testing constructors that throw..." << std::endl;
+	{
+		sjtu::concurrent_vector<Fragile> v;
+		Fragile seven(7);
+		v.push_back(seven);
+		Fragile::copiesLeft = 3;
+		try {
+			v.grow_by(10, seven);
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		std::cout << v.size() << " " << Fragile::live << " " << v[3].value << " " << v[4].value << " " << v[10].value << std::endl;
+		Fragile::copiesLeft = 0;
+		try {
+			v.push_back(seven);
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		std::cout << v.size() << " " << Fragile::live << " " << v[11].value << std::endl;
+		Fragile::copiesLeft = 5;
+		try {
+			sjtu::concurrent_vector<Fragile> w(v);
+		} catch (...) {
+			std::cout << "exceptions thrown correctly." << std::endl;
+		}
+		Fragile::copiesLeft = -1;
+		std::cout << Fragile::live << std::endl;
+	}
+	std::cout << Fragile::live << std::endl;
+}
+
+void TestStress()
+{
+	std::cout << "Testing concurrent producers..." << std::endl;
+	sjtu::concurrent_vector<long long> v;
+	std::thread threads[THREADS];
+	for (int t = 0; t < THREADS; ++t) {
+		threads[t] = std::thread([&v, t] {
+			for (int i = 0; i < PER_THREAD; ++i) {
+				long long value = (long long)t * PER_THREAD + i;
+				if (i % 100 == 0) {
+					size_t first = v.grow_by(3, -1);
+					v[first + 1] = value;
+				} else {
+					size_t at = v.push_back(value);
+					// a slot this thread got back is readable right away
+					if (v[at] != value) {
+						std::cout << "wrong value" << std::endl;
+					}
+				}
+			}
+		});
+	}
+	for (int t = 0; t < THREADS; ++t) {
+		threads[t].join();
+	}
+	sjtu::vector<char> seen;
+	seen.resize((size_t)THREADS * PER_THREAD);
+	size_t fillers = 0;
+	bool ok = true;
+	for (size_t i = 0; i < v.size(); ++i) {
+		if (v[i] == -1) {
+			fillers++;
+			continue;
+		}
+		if (v[i] < 0 || v[i] >= (long long)THREADS * PER_THREAD || seen[v[i]]) {
+			ok = false;
+		} else {
+			seen[v[i]] = 1;
+		}
+	}
+	for (size_t i = 0; i < seen.size(); ++i) {
+		ok = ok && seen[i];
+	}
+	std::cout << v.size() << " " << fillers << " " << (ok ? "every value once" : "lost or duplicated values") << std::endl;
+}
+
+template<typename Push>
+double TimeProducers(Push push)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::thread threads[THREADS];
+	for (int t = 0; t < THREADS; ++t) {
+		threads[t] = std::thread([&push, t] {
+			for (int i = 0; i < PER_THREAD * 5; ++i) {
+				push((long long)t * PER_THREAD + i);
+			}
+		});
+	}
+	for (int t = 0; t < THREADS; ++t) {
+		threads[t].join();
+	}
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Bench()
+{
+	sjtu::vector<long long> locked;
+	std::mutex lock;
+	double mutexTime = TimeProducers([&](long long x) {
+		std::lock_guard<std::mutex> guard(lock);
+		locked.push_back(x);
+	});
+	sjtu::concurrent_vector<long long> v;
+	double lockFreeTime = TimeProducers([&](long long x) { v.push_back(x); });
+	double total = (double)THREADS * PER_THREAD * 5;
+	std::cout << THREADS << " threads, " << total << " push_backs" << std::endl;
+	std::cout << "mutex + sjtu::vector: " << total / mutexTime / 1e6 << " M/s" << std::endl;
+	std::cout << "concurrent_vector:    " << total / lockFreeTime / 1e6 << " M/s" << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc > 1 && std::strcmp(argv[1], "bench") == 0) {
+		Bench();
+		return 0;
+	}
+	TestBasic();
+	TestThrowing();
+	TestStress();
+	return 0;
+}
@@ -0,0 +1,66 @@
+#include "mmap_vector.hpp"
+
+#include <cstdio>
+#include <iostream>
+
+struct Record {
+	long long id;
+	double price;
+	int qty;
+};
+
+const char *path = "mmap_vector_test.bin";
+
+void TestCreate()
+{
+	std::cout << "Testing creating a dataset..." << std::endl;
+	std::remove(path);
+	sjtu::mmap_vector<Record> v(path);
+	std::cout << v.size() << std::endl;
+	for (int i = 0; i < 100000; ++i) {
+		v.push_back(Record{i, i * 0.5, i % 7});
+	}
+	v.append(v.data(), 10);
+	v.pop_back();
+	v.sync();
+	std::cout << v.size() << " " << v.back().id << " " << v[99999].price << std::endl;
+}
+
+void TestReopen()
+{
+	std::cout << "Testing reopening a dataset..." << std::endl;
+	sjtu::mmap_vector<Record> v(path);
+	long long sum = 0;
+	for (sjtu::mmap_vector<Record>::const_iterator it = v.cbegin(); it != v.cend(); ++it) {
+		sum += it->qty;
+	}
+	std::cout << v.size() << " " << sum << " " << v.front().price << std::endl;
+	v.resize(5);
+	v.resize(7);
+	std::cout << v.size() << " " << v[4].id << " " << v[6].id << std::endl;
+	try {
+		v.at(7);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestWrongType()
+{
+	std::cout << "Testing opening a dataset as another type..." << std::endl;
+	try {
+		sjtu::mmap_vector<char[3]> v(path);
+		std::cout << "opened" << std::endl;
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	std::remove(path);
+}
+
+int main()
+{
+	TestCreate();
+	TestReopen();
+	TestWrongType();
+	return 0;
+}
@@ -0,0 +1,96 @@
+#define SJTU_UNCHECKED
+#include "vector.hpp"
+
+#include <iostream>
+#include <type_traits>
+
+static_assert(std::is_pointer<sjtu::vector<int>::iterator>::value, "unchecked iterators are plain pointers");
+static_assert(std::is_pointer<sjtu::vector<int>::const_iterator>::value, "unchecked iterators are plain pointers");
+
+void TestIterators()
+{
+	std::cout << "Testing unchecked iterators..." << std::endl;
+	sjtu::vector<long long> v;
+	for (long long i = 0; i < 100; ++i) {
+		v.push_back(i);
+	}
+	long long sum = 0;
+	for (sjtu::vector<long long>::iterator it = v.begin(); it != v.end(); ++it) {
+		*it *= 2;
+		sum += *it;
+	}
+	const sjtu::vector<long long> &cv = v;
+	std::cout << sum << " " << (cv.cend() - cv.cbegin()) << " " << *(cv.cbegin() + 10) << std::endl;
+}
+
+void TestModifiers()
+{
+	std::cout << "Testing modifiers returning fresh iterators..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	// the buffer is full, so this insert reallocates and the old begin() dangles
+	sjtu::vector<int>::iterator it = v.insert(v.begin() + 4, 100);
+	std::cout << *it << " " << (it - v.begin()) << std::endl;
+	it = v.insert(v.end(), 30, 7);
+	std::cout << *it << " " << (it - v.begin()) << " " << v.size() << std::endl;
+	it = v.erase(v.begin() + 1, v.begin() + 5);
+	std::cout << *it << " " << v.size() << std::endl;
+	it = v.emplace(v.begin(), -5);
+	std::cout << *it << " " << v[1] << std::endl;
+}
+
+void TestIndexModifiers()
+{
+	std::cout << "Testing index insert and erase..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 5; ++i) {
+		v.push_back(i);
+	}
+	v.insert(0, 10);
+	int x = 20;
+	v.insert(0, x);
+	v.insert(3, std::move(x));
+	v.erase(0);
+	int last = 6;
+	v.erase(last);
+	size_t ind = 1;
+	v.insert(ind, 30);
+	v.erase(ind);
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+	try {
+		v.erase(7);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		v.insert(-1, 0);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestAt()
+{
+	std::cout << "Testing at() still checks..." << std::endl;
+	sjtu::vector<int> v;
+	v.push_back(1);
+	try {
+		v.at(1);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	TestIterators();
+	TestModifiers();
+	TestIndexModifiers();
+	TestAt();
+	return 0;
+}
@@ -0,0 +1,54 @@
+#include "simd.hpp"
+
+#include <iostream>
+
+template<typename T>
+void Report(const sjtu::vector<T> &v, const T &key)
+{
+	std::cout << (sjtu::find(v, key) - v.cbegin()) << " "
+	          << sjtu::count(v, key) << " "
+	          << sjtu::sum(v) << " "
+	          << (sjtu::min_element(v) - v.cbegin()) << " "
+	          << (sjtu::max_element(v) - v.cbegin()) << std::endl;
+}
+
+template<typename T>
+void TestType(const char *name, int n)
+{
+	std::cout << "Testing " << name << " with " << n << " elements..." << std::endl;
+	sjtu::vector<T> v;
+	unsigned int seed = 2021;
+	for (int i = 0; i < n; ++i) {
+		seed = seed * 1103515245u + 12345u;
+		v.push_back(T(int(seed >> 16) % 2001 - 1000));
+	}
+	T key = n > 7 ? v[n - 3] : T(5);
+	T missing = T(99999);
+	sjtu::simd::level levels[] = {sjtu::simd::SCALAR, sjtu::simd::SSE2, sjtu::simd::AVX2};
+	for (int l = 0; l < 3; ++l) {
+		// every level must agree with the plain loops
+		sjtu::simd::limit(levels[l]);
+		Report(v, key);
+		std::cout << (sjtu::find(v, missing) == v.cend() ? "not found" : "found") << std::endl;
+	}
+}
+
+void TestEmpty()
+{
+	std::cout << "Testing empty vectors..." << std::endl;
+	sjtu::vector<int> v;
+	std::cout << (sjtu::find(v, 1) == v.cend()) << " " << sjtu::count(v, 1) << " " << sjtu::sum(v) << " "
+	          << (sjtu::min_element(v) == v.cend()) << " " << (sjtu::max_element(v) == v.cend()) << std::endl;
+}
+
+int main()
+{
+	TestType<int>("int", 1000003);
+	TestType<int>("int", 7);
+	TestType<long long>("long long", 999999);
+	TestType<long long>("long long", 3);
+	TestType<double>("double", 1000001);
+	TestType<short>("short", 1000);
+	TestEmpty();
+	return 0;
+}
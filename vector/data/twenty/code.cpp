@@ -0,0 +1,115 @@
+#include "bitvector.hpp"
+
+#include <iostream>
+
+#include <vector>
+
+void TestProxy()
+{
+	std::cout << "Testing proxy references..." << std::endl;
+	sjtu::bitvector v;
+	for (int i = 0; i < 200; ++i) {
+		v.push_back(i % 3 == 0);
+	}
+	v[1] = true;
+	v[0] = v[2];
+	v[5].flip();
+	bool b = v[3];
+	std::cout << v.size() << " " << v[0] << v[1] << v[2] << b << v[5] << " " << ~v[3] << " " << v.count() << std::endl;
+	int ones = 0;
+	for (sjtu::bitvector::iterator it = v.begin(); it != v.end(); ++it) {
+		if (*it) {
+			ones++;
+		}
+		*it = !*it;
+	}
+	const sjtu::bitvector &cv = v;
+	std::cout << ones << " " << cv.count() << " " << cv.front() << " " << cv.back() << " " << (cv.cend() - cv.cbegin()) << std::endl;
+	try {
+		v.at(200);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	v.pop_back();
+	v.resize(70);
+	v.resize(300, true);
+	std::cout << v.size() << " " << v.count() << " " << v.find_first() << " " << v.find_next(69) << std::endl;
+}
+
+void TestAgainstReference()
+{
+	std::cout << "Testing word-level operations against std::vector<char>..." << std::endl;
+	const size_t n = 100003;
+	sjtu::bitvector a(n), b(n, true);
+	std::vector<char> ra(n, 0), rb(n, 1);
+	unsigned seed = 7;
+	for (size_t i = 0; i < n; ++i) {
+		seed = seed * 1103515245 + 12345;
+		if ((seed >> 16) % 7 == 0) {
+			a[i] = true;
+			ra[i] = 1;
+		}
+		if ((seed >> 16) % 5 == 0) {
+			b[i] = false;
+			rb[i] = 0;
+		}
+	}
+	b.set(1000, 5000, false);
+	for (size_t i = 1000; i < 5000; ++i) {
+		rb[i] = 0;
+	}
+	sjtu::bitvector c = a & b, d = a | b, e = a ^ b;
+	bool ok = true;
+	size_t count = 0;
+	for (size_t i = 0; i < n; ++i) {
+		ok = ok && c[i] == (ra[i] && rb[i]) && d[i] == (ra[i] || rb[i]) && e[i] == (ra[i] != rb[i]);
+		count += ra[i];
+	}
+	std::cout << ok << " " << (a.count() == count) << " " << c.count() << " " << d.count() << " " << e.count() << std::endl;
+	size_t found = 0;
+	ok = true;
+	size_t expect = 0;
+	for (size_t pos = a.find_first(); pos < a.size(); pos = a.find_next(pos + 1)) {
+		while (!ra[expect]) {
+			expect++;
+		}
+		ok = ok && pos == expect;
+		expect++;
+		found++;
+	}
+	std::cout << ok << " " << (found == count) << std::endl;
+	size_t slow[5];
+	size_t at[5] = {0, 63, 64, 4097, n};
+	for (int k = 0; k < 5; ++k) {
+		slow[k] = a.rank(at[k]);
+	}
+	a.build_rank();
+	ok = true;
+	size_t running = 0;
+	for (size_t i = 0; i <= n; ++i) {
+		ok = ok && a.rank(i) == running;
+		if (i < n) {
+			running += ra[i];
+		}
+	}
+	for (int k = 0; k < 5; ++k) {
+		ok = ok && a.rank(at[k]) == slow[k];
+	}
+	a[0] = !a[0];
+	std::cout << ok << " " << (long long)a.rank(n) - (long long)count << " " << slow[3] << std::endl;
+	a.flip();
+	std::cout << a.count() + count - 1 << std::endl;
+	try {
+		sjtu::bitvector small(10);
+		a &= small;
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+int main()
+{
+	TestProxy();
+	TestAgainstReference();
+	return 0;
+}
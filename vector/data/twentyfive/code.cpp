@@ -0,0 +1,70 @@
+#include "vector.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+struct Counted {
+	static int made;
+	int value;
+	Counted() : value(-1) { made++; }
+	Counted(const Counted &other) : value(other.value) {}
+};
+
+int Counted::made = 0;
+
+void TestTrivial()
+{
+	std::cout << "Testing uninitialized growth of trivial types..." << std::endl;
+	sjtu::vector<int> v;
+	v.push_back(1);
+	v.push_back(2);
+	v.resize_uninitialized(1000);
+	std::cout << v.size() << " " << v[0] << " " << v[1] << std::endl;
+	for (size_t i = 2; i < v.size(); ++i) {
+		v[i] = (int)i;
+	}
+	long long sum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		sum += v[i];
+	}
+	std::cout << sum << std::endl;
+	v.resize(10, sjtu::default_init);
+	std::cout << v.size() << " " << v.back() << " " << (v.capacity() >= 1000) << std::endl;
+
+	std::FILE *f = std::tmpfile();
+	double out[300];
+	for (int i = 0; i < 300; ++i) {
+		out[i] = i * 0.5;
+	}
+	std::fwrite(out, sizeof(double), 300, f);
+	std::rewind(f);
+	sjtu::vector<double> d;
+	d.push_back(-1);
+	d.resize_uninitialized(d.size() + 300);
+	size_t got = std::fread(d.data() + 1, sizeof(double), 300, f);
+	std::fclose(f);
+	std::cout << got << " " << d.size() << " " << d[0] << " " << d[1] << " " << d[300] << std::endl;
+}
+
+void TestNonTrivial()
+{
+	std::cout << "Testing default_init of other types..." << std::endl;
+	sjtu::vector<Counted> c;
+	c.resize(5, sjtu::default_init);
+	std::cout << c.size() << " " << Counted::made << " " << c[4].value << std::endl;
+	sjtu::vector<std::string> s;
+	s.push_back("keep");
+	s.resize(40, sjtu::default_init);
+	std::cout << s.size() << " " << s[0] << " " << s[39].empty() << std::endl;
+	s.resize(1, sjtu::default_init);
+	std::cout << s.size() << " " << s.back() << std::endl;
+}
+
+int main()
+{
+	TestTrivial();
+	TestNonTrivial();
+	return 0;
+}
@@ -0,0 +1,89 @@
+#include "small_vector.hpp"
+#include "span.hpp"
+#include "vector.hpp"
+
+#include <iostream>
+
+long long Sum(sjtu::const_span<int> s)
+{
+	long long sum = 0;
+	for (int x : s) {
+		sum += x;
+	}
+	return sum;
+}
+
+void Scale(sjtu::span<int> s, int k)
+{
+	for (sjtu::span<int>::iterator it = s.begin(); it != s.end(); ++it) {
+		*it *= k;
+	}
+}
+
+void TestSlices()
+{
+	std::cout << "Testing slices of a vector..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 100; ++i) {
+		v.push_back(i);
+	}
+	sjtu::span<int> all(v);
+	std::cout << all.size() << " " << all.size_bytes() << " " << (all.data() == v.data()) << " " << Sum(v) << std::endl;
+	sjtu::span<int> mid = all.subspan(10, 20);
+	std::cout << mid.front() << " " << mid.back() << " " << Sum(mid) << std::endl;
+	Scale(mid.first(5), 100);
+	Scale(mid.last(5), -1);
+	std::cout << v[10] << " " << v[14] << " " << v[15] << " " << v[25] << " " << v[29] << " " << v[30] << std::endl;
+	sjtu::span<int> tail = all.subspan(95);
+	std::cout << tail.size() << " " << tail[0] << " " << all.subspan(100).empty() << " " << all.first(0).size() << std::endl;
+	sjtu::const_span<int> view = mid;
+	std::cout << view.size() << " " << view.at(0) << " " << Sum(all.subspan(0, 10)) << std::endl;
+	try {
+		all.subspan(101);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		all.subspan(90, 11);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		mid.at(20);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		sjtu::span<int>().front();
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestSources()
+{
+	std::cout << "Testing other sources..." << std::endl;
+	sjtu::vector<int> v;
+	v.resize(5, 7);
+	const sjtu::vector<int> &cv = v;
+	sjtu::const_span<int> c(cv);
+	std::cout << c.size() << " " << Sum(c) << std::endl;
+	sjtu::small_vector<int, 8> sv;
+	for (int i = 1; i <= 6; ++i) {
+		sv.push_back(i);
+	}
+	sjtu::span<int> s(sv);
+	Scale(s.subspan(2, 2), 10);
+	std::cout << Sum(sv) << " " << sv[2] << " " << sv[3] << std::endl;
+	int raw[] = {4, 5, 6, 7};
+	sjtu::span<int> r(raw, raw + 4);
+	sjtu::span<int> r2(raw + 1, 2);
+	std::cout << Sum(r) << " " << Sum(r2) << " " << Sum(sjtu::span<int>()) << std::endl;
+}
+
+int main()
+{
+	TestSlices();
+	TestSources();
+	return 0;
+}
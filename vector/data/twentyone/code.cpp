@@ -0,0 +1,138 @@
+#include "soa_vector.hpp"
+
+#include <iostream>
+#include <string>
+
+#include <vector>
+
+struct Particle {
+	int id;
+	double mass;
+	std::string name;
+};
+
+typedef sjtu::soa_vector<int, double, std::string> Particles;
+
+bool Same(const Particles &v, const std::vector<Particle> &ref)
+{
+	if (v.size() != ref.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < ref.size(); ++i) {
+		if (v[i].get<0>() != ref[i].id || v[i].get<1>() != ref[i].mass || v[i].get<2>() != ref[i].name) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestRows()
+{
+	std::cout << "Testing rows and proxies..." << std::endl;
+	Particles v;
+	std::cout << v.size() << " " << v.capacity() << " " << v.empty() << std::endl;
+	v.push_back(1, 1.5, std::string("alpha"));
+	v.push_back(std::make_tuple(2, 2.5, std::string("beta")));
+	v.push_back(3, 3.5, std::string("gamma"));
+	v.insert(1, std::make_tuple(4, 4.5, std::string("delta")));
+	v.insert(v.begin(), std::make_tuple(5, 5.5, std::string("epsilon")));
+	for (Particles::iterator it = v.begin(); it != v.end(); ++it) {
+		std::cout << (*it).get<0>() << " " << (*it).get<1>() << " " << (*it).get<2>() << std::endl;
+	}
+	v[0].get<2>() += "!";
+	v[1] = std::make_tuple(6, 6.5, std::string("zeta"));
+	v[2] = v[3];
+	std::tuple<int, double, std::string> row = v[0];
+	std::cout << std::get<0>(row) << " " << std::get<2>(row) << " " << v[1].get<2>() << " " << v[2].get<2>() << std::endl;
+	v.erase(v.begin() + 1);
+	v.erase(0);
+	v.pop_back();
+	std::cout << v.size() << " " << v.front().get<2>() << " " << v.back().get<0>() << " " << (v.cend() - v.cbegin()) << std::endl;
+	try {
+		v.at(2);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		v.insert(3, row);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	v.clear();
+	try {
+		v.pop_back();
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+}
+
+void TestAgainstReference()
+{
+	std::cout << "Testing against an array of structs..." << std::endl;
+	Particles v;
+	std::vector<Particle> ref;
+	unsigned seed = 11;
+	for (int step = 0; step < 20000; ++step) {
+		seed = seed * 1103515245 + 12345;
+		unsigned r = seed >> 16;
+		if (r % 4 != 0 || ref.empty()) {
+			Particle p = {step, step * 0.25, std::to_string(r)};
+			size_t pos = r % (ref.size() + 1);
+			v.insert(pos, std::make_tuple(p.id, p.mass, p.name));
+			ref.insert(ref.begin() + pos, p);
+		} else {
+			size_t pos = r % ref.size();
+			v.erase(pos);
+			ref.erase(ref.begin() + pos);
+		}
+	}
+	std::cout << v.size() << " " << Same(v, ref) << std::endl;
+	Particles copy(v);
+	copy.push_back(copy[0].get<0>(), copy[0].get<1>(), copy[0].get<2>());
+	Particles moved(std::move(copy));
+	std::cout << copy.size() << " " << moved.size() << " " << moved.back().get<2>() << " " << (moved.back().get<2>() == v[0].get<2>()) << std::endl;
+	moved = v;
+	std::cout << Same(moved, ref) << std::endl;
+	moved.shrink_to_fit();
+	std::cout << (moved.capacity() == moved.size()) << " " << Same(moved, ref) << std::endl;
+	moved.reserve(moved.size() * 3);
+	std::cout << Same(moved, ref) << std::endl;
+}
+
+void TestColumns()
+{
+	std::cout << "Testing column scans..." << std::endl;
+	Particles v;
+	v.reserve(1000);
+	size_t capacity = v.capacity();
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(i, i * 0.5, std::string(i % 7, 'x'));
+	}
+	std::cout << (v.capacity() == capacity) << std::endl;
+	const int *ids = v.column<0>();
+	double *mass = v.column<1>();
+	long long idSum = 0;
+	for (size_t i = 0; i < v.size(); ++i) {
+		idSum += ids[i];
+		mass[i] *= 2;
+	}
+	const Particles &cv = v;
+	double massSum = 0;
+	const double *cmass = cv.column<1>();
+	for (size_t i = 0; i < cv.size(); ++i) {
+		massSum += cmass[i];
+	}
+	size_t letters = 0;
+	for (Particles::const_iterator it = cv.cbegin(); it != cv.cend(); ++it) {
+		letters += (*it).get<2>().size();
+	}
+	std::cout << idSum << " " << massSum << " " << letters << std::endl;
+}
+
+int main()
+{
+	TestRows();
+	TestAgainstReference();
+	TestColumns();
+	return 0;
+}
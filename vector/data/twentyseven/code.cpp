@@ -0,0 +1,107 @@
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+#include <algorithm>
+#include <vector>
+
+struct Order {
+	int price;
+	int id;
+};
+
+unsigned seed = 23;
+
+unsigned Next()
+{
+	seed = seed * 1103515245 + 12345;
+	return seed >> 16;
+}
+
+void TestInsertSorted()
+{
+	std::cout << "Testing insert_sorted..." << std::endl;
+	sjtu::vector<int> v;
+	std::vector<int> ref;
+	for (int i = 0; i < 5000; ++i) {
+		int x = (int)(Next() % 1000) - 500;
+		sjtu::vector<int>::iterator it = v.insert_sorted(x);
+		ref.insert(std::upper_bound(ref.begin(), ref.end(), x), x);
+		if (*it != x) {
+			std::cout << "wrong iterator" << std::endl;
+		}
+	}
+	bool same = v.size() == ref.size();
+	for (size_t i = 0; same && i < ref.size(); ++i) {
+		same = v[i] == ref[i];
+	}
+	v.insert_sorted(v[2500]);
+	v.insert_sorted(-1000);
+	v.insert_sorted(1000);
+	std::cout << same << " " << v.size() << " " << v.front() << " " << v.back() << " " << std::is_sorted(v.data(), v.data() + v.size()) << std::endl;
+
+	sjtu::vector<Order> book;
+	auto better = [](const Order &a, const Order &b) { return a.price > b.price; };
+	for (int id = 0; id < 12; ++id) {
+		Order o = {100 + (id * 7) % 4, id};
+		book.insert_sorted(o, better);
+	}
+	for (size_t i = 0; i < book.size(); ++i) {
+		std::cout << book[i].price << ":" << book[i].id << " ";
+	}
+	std::cout << std::endl;
+
+	sjtu::vector<std::string> words;
+	const char *input[] = {"pear", "apple", "fig", "kiwi", "banana", "apple"};
+	for (const char *w : input) {
+		words.insert_sorted(std::string(w));
+	}
+	std::string s("cherry");
+	words.insert_sorted(s);
+	for (size_t i = 0; i < words.size(); ++i) {
+		std::cout << words[i] << " ";
+	}
+	std::cout << s << std::endl;
+}
+
+void TestEraseIf()
+{
+	std::cout << "Testing erase_if..." << std::endl;
+	sjtu::vector<int> v;
+	std::vector<int> ref;
+	for (int i = 0; i < 100000; ++i) {
+		int x = (int)Next();
+		v.push_back(x);
+		ref.push_back(x);
+	}
+	auto odd = [](int x) { return x % 2 != 0; };
+	size_t removed = v.erase_if(odd);
+	ref.erase(std::remove_if(ref.begin(), ref.end(), odd), ref.end());
+	bool same = v.size() == ref.size();
+	for (size_t i = 0; same && i < ref.size(); ++i) {
+		same = v[i] == ref[i];
+	}
+	std::cout << removed << " " << v.size() << " " << same << std::endl;
+	std::cout << v.erase_if([](int) { return false; }) << " " << v.erase_if([](int) { return true; }) << " " << v.size() << " " << v.empty() << std::endl;
+	std::cout << v.erase_if(odd) << std::endl;
+
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 30; ++i) {
+		s.push_back(std::string(i % 5 + 1, 'a' + i % 26));
+	}
+	std::cout << s.erase_if([](const std::string &x) { return x.size() > 2; }) << " ";
+	for (size_t i = 0; i < s.size(); ++i) {
+		std::cout << s[i] << " ";
+	}
+	std::cout << std::endl;
+	s.push_back("tail");
+	std::cout << s.size() << " " << s.back() << std::endl;
+}
+
+int main()
+{
+	TestInsertSorted();
+	TestEraseIf();
+	return 0;
+}
@@ -0,0 +1,123 @@
+#include "vector.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+// hands out one static slot whatever the size asked for, for a vector
+// whose elements are never read or written
+template<class T>
+class unbacked_allocator {
+public:
+	typedef T value_type;
+	static size_t requested;
+	unbacked_allocator() {}
+	template<class U>
+	unbacked_allocator(const unbacked_allocator<U> &) {}
+	T *allocate(size_t n)
+	{
+		static T slot;
+		// read back through volatile, so the optimizer cannot see the slot is one T
+		T *volatile p = &slot;
+		requested = n;
+		return p;
+	}
+	void deallocate(T *, size_t) {}
+	bool operator == (const unbacked_allocator &) const { return true; }
+	bool operator != (const unbacked_allocator &) const { return false; }
+};
+template<class T>
+size_t unbacked_allocator<T>::requested = 0;
+
+void TestFootprint()
+{
+	std::cout << "Testing footprint and lazy allocation..." << std::endl;
+	std::cout << sizeof(sjtu::compact_vector<int>) << " " << sizeof(sjtu::compact_vector<std::string>) << " "
+	          << sizeof(sjtu::vector<int>) << " " << (sizeof(sjtu::vector<int, sjtu::double_growth, sjtu::counting_allocator<int>>) > sizeof(sjtu::vector<int>)) << std::endl;
+	sjtu::allocation_stats stats;
+	sjtu::counting_allocator<int> a(stats);
+	{
+		sjtu::vector<sjtu::vector<int, sjtu::double_growth, sjtu::counting_allocator<int>>> many;
+		many.reserve(1000);
+		for (int i = 0; i < 1000; ++i) {
+			many.emplace_back(a);
+		}
+		std::cout << stats.allocations << " " << many[0].capacity() << " " << many[0].empty() << " " << (many[0].data() == nullptr) << std::endl;
+		many[7].push_back(1);
+		std::cout << stats.allocations << " " << many[7].capacity() << std::endl;
+	}
+	std::cout << stats.live() << std::endl;
+	sjtu::vector<int> v;
+	std::cout << v.capacity() << " " << (v.cbegin() == v.cend()) << std::endl;
+	v.shrink_to_fit();
+	v.clear();
+	v.push_back(3);
+	std::cout << v.size() << " " << v.capacity() << " " << v.back() << std::endl;
+}
+
+void TestCompact()
+{
+	std::cout << "Testing compact_vector..." << std::endl;
+	sjtu::compact_vector<std::string> v;
+	for (int i = 0; i < 50; ++i) {
+		v.push_back(std::to_string(i));
+	}
+	v.insert(v.begin() + 3, "x");
+	v.erase(v.begin());
+	v.erase(10);
+	sjtu::compact_vector<std::string> w(v);
+	sjtu::compact_vector<std::string> m(std::move(w));
+	std::cout << v.size() << " " << v[0] << " " << v[2] << " " << v[10] << " " << m.size() << " " << w.size() << " " << m.back() << std::endl;
+	std::string joined;
+	for (sjtu::compact_vector<std::string>::iterator it = m.begin(); it != m.begin() + 5; ++it) {
+		joined += *it;
+	}
+	std::cout << joined << " " << (m.end() - m.begin()) << std::endl;
+	m.resize(2);
+	m.shrink_to_fit();
+	std::cout << m.size() << " " << m.capacity() << std::endl;
+}
+
+void TestLimit()
+{
+	std::cout << "Testing the size limit..." << std::endl;
+	sjtu::compact_vector<int, uint8_t> v;
+	for (int i = 0; i < 255; ++i) {
+		v.push_back(i);
+	}
+	std::cout << v.size() << " " << v.capacity() << " " << v.back() << std::endl;
+	try {
+		v.push_back(255);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		v.reserve(256);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	std::cout << v.size() << " " << v[254] << std::endl;
+	// the elements are never touched, so the allocator needs no real memory
+	sjtu::compact_vector<char, uint32_t, unbacked_allocator<char> > big;
+	big.resize_uninitialized(UINT32_MAX);
+	std::cout << big.size() << " " << big.capacity() << " " << unbacked_allocator<char>::requested << std::endl;
+	try {
+		big.push_back('a');
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	try {
+		big.emplace(big.begin(), 'a');
+	} catch (const sjtu::runtime_error &) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	std::cout << big.size() << " " << big.capacity() << " " << unbacked_allocator<char>::requested << std::endl;
+}
+
+int main()
+{
+	TestFootprint();
+	TestCompact();
+	TestLimit();
+	return 0;
+}
@@ -0,0 +1,169 @@
+#include "serialize.hpp"
+#include "vector.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+struct Point {
+	int x;
+	double y;
+};
+
+namespace sjtu {
+template <>
+struct serializer<std::string> {
+	static void write(writer &out, const std::string &value)
+	{
+		out.write((uint32_t)value.size());
+		out.write(value.data(), value.size());
+	}
+
+	static std::string read(reader &in)
+	{
+		std::string value(in.read<uint32_t>(), '\0');
+		in.read(&value[0], value.size());
+		return value;
+	}
+};
+
+template <>
+struct serializer<sjtu::vector<int>> {
+	static void write(writer &out, const sjtu::vector<int> &value)
+	{
+		save(value, out);
+	}
+
+	static sjtu::vector<int> read(reader &in)
+	{
+		sjtu::vector<int> value;
+		load(value, in);
+		return value;
+	}
+};
+}
+
+void TestFile()
+{
+	std::cout << "Testing FILE* round trips..." << std::endl;
+	sjtu::vector<int> a;
+	sjtu::vector<Point> b;
+	sjtu::vector<std::string> c;
+	for (int i = 0; i < 100000; ++i) {
+		a.push_back(i * 7 - 3);
+	}
+	for (int i = 0; i < 1000; ++i) {
+		Point p = {i, i / 4.0};
+		b.push_back(p);
+		c.push_back(std::string(i % 13, 'a' + i % 26));
+	}
+	std::FILE *f = std::tmpfile();
+	sjtu::save(a, f);
+	sjtu::save(b, f);
+	sjtu::save(c, f);
+	sjtu::save(sjtu::vector<int>(), f);
+	long bytes = std::ftell(f);
+	std::rewind(f);
+	sjtu::vector<int> a2;
+	sjtu::vector<Point> b2;
+	sjtu::vector<std::string> c2;
+	sjtu::vector<int> empty;
+	empty.push_back(1);
+	sjtu::load(a2, f);
+	sjtu::load(b2, f);
+	sjtu::load(c2, f);
+	sjtu::load(empty, f);
+	bool same = a2.size() == a.size() && b2.size() == b.size() && c2.size() == c.size();
+	for (size_t i = 0; same && i < a.size(); ++i) {
+		same = a2[i] == a[i];
+	}
+	for (size_t i = 0; same && i < b.size(); ++i) {
+		same = b2[i].x == b[i].x && b2[i].y == b[i].y && c2[i] == c[i];
+	}
+	std::cout << bytes << " " << same << " " << empty.size() << " " << c2[25] << std::endl;
+	try {
+		sjtu::load(a2, f);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	std::cout << a2.size() << std::endl;
+	std::fclose(f);
+}
+
+void TestBuffer()
+{
+	std::cout << "Testing buffers..." << std::endl;
+	sjtu::vector<sjtu::vector<int>> nested;
+	for (int i = 0; i < 5; ++i) {
+		sjtu::vector<int> row;
+		for (int j = 0; j <= i; ++j) {
+			row.push_back(i * 10 + j);
+		}
+		nested.push_back(row);
+	}
+	sjtu::vector<double> d;
+	d.push_back(0.5);
+	d.push_back(-2.25);
+	sjtu::vector<char> buffer;
+	sjtu::save(nested, buffer);
+	size_t first = buffer.size();
+	sjtu::save(d, buffer);
+	std::cout << first << " " << buffer.size() << std::endl;
+	sjtu::vector<sjtu::vector<int>> nested2;
+	sjtu::vector<double> d2;
+	size_t used = sjtu::load(nested2, buffer.data(), buffer.size());
+	used += sjtu::load(d2, buffer.data() + used, buffer.size() - used);
+	std::cout << used << " " << nested2.size() << " " << nested2[4].size() << " " << nested2[4][3] << " " << d2[1] << std::endl;
+}
+
+void TestErrors()
+{
+	std::cout << "Testing bad input..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	sjtu::vector<char> buffer;
+	sjtu::save(v, buffer);
+	sjtu::vector<int> out;
+	try {
+		sjtu::load(out, buffer.data(), buffer.size() - 1);
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	sjtu::vector<long long> wide;
+	try {
+		sjtu::load(wide, buffer.data(), buffer.size());
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	sjtu::vector<std::string> strings;
+	try {
+		sjtu::load(strings, buffer.data(), buffer.size());
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	buffer[8] = 2;
+	try {
+		sjtu::load(out, buffer.data(), buffer.size());
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	buffer[8] = 1;
+	buffer[0] = 'X';
+	try {
+		sjtu::load(out, buffer.data(), buffer.size());
+	} catch (...) {
+		std::cout << "exceptions thrown correctly." << std::endl;
+	}
+	buffer[0] = 'S';
+	std::cout << sjtu::load(out, buffer.data(), buffer.size()) << " " << out.size() << " " << out.back() << std::endl;
+}
+
+int main()
+{
+	TestFile();
+	TestBuffer();
+	TestErrors();
+	return 0;
+}
@@ -0,0 +1,173 @@
+#include "sort.hpp"
+#include "vector.hpp"
+
+#include <iostream>
+#include <string>
+
+#include <algorithm>
+#include <vector>
+
+struct Record {
+	int key;
+	int order;
+};
+
+unsigned seed = 19;
+
+unsigned Next()
+{
+	seed = seed * 1103515245 + 12345;
+	return seed >> 8;
+}
+
+template <typename T>
+bool Same(sjtu::vector<T> &v, const std::vector<T> &ref)
+{
+	if (v.size() != ref.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < ref.size(); ++i) {
+		if (!(v[i] == ref[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename T>
+void Check(const char *name, const std::vector<T> &input)
+{
+	sjtu::vector<T> a, b, c;
+	for (size_t i = 0; i < input.size(); ++i) {
+		a.push_back(input[i]);
+		b.push_back(input[i]);
+		c.push_back(input[i]);
+	}
+	std::vector<T> ref(input);
+	std::sort(ref.begin(), ref.end());
+	sjtu::sort(a.begin(), a.end());
+	sjtu::stable_sort(b.begin(), b.end());
+	sjtu::sort(c.begin(), c.end(), [](const T &x, const T &y) { return y < x; });
+	std::reverse(ref.begin(), ref.end());
+	bool descending = Same(c, ref);
+	std::reverse(ref.begin(), ref.end());
+	std::cout << name << " " << input.size() << " " << Same(a, ref) << Same(b, ref) << descending << std::endl;
+}
+
+void TestShapes()
+{
+	std::cout << "Testing input shapes..." << std::endl;
+	for (size_t n : {0, 1, 2, 17, 255, 256, 1000, 100000}) {
+		std::vector<int> random, sorted, reversed, equal, pipe, few;
+		for (size_t i = 0; i < n; ++i) {
+			random.push_back((int)Next() - (1 << 23));
+			sorted.push_back((int)i);
+			reversed.push_back((int)(n - i));
+			equal.push_back(42);
+			pipe.push_back((int)(i < n / 2 ? i : n - i));
+			few.push_back((int)(Next() % 4) - 2);
+		}
+		Check("random", random);
+		Check("sorted", sorted);
+		Check("reversed", reversed);
+		Check("equal", equal);
+		Check("pipe", pipe);
+		Check("few", few);
+	}
+}
+
+void TestTypes()
+{
+	std::cout << "Testing element types..." << std::endl;
+	std::vector<double> d;
+	std::vector<float> f;
+	std::vector<long double> ld;
+	std::vector<long long> ll;
+	std::vector<unsigned> u;
+	std::vector<unsigned char> uc;
+	std::vector<signed char> sc;
+	std::vector<bool> bits;
+	std::vector<std::string> s;
+	for (int i = 0; i < 5000; ++i) {
+		unsigned r = Next();
+		d.push_back(((double)r - (1 << 23)) / 1024.0);
+		f.push_back(((float)(r % 2001) - 1000.0f) / 8.0f);
+		ld.push_back(((long double)r - (1 << 23)) / 3.0L);
+		ll.push_back(((long long)r << 20) * (r % 2 ? -1 : 1));
+		u.push_back(r * 2654435761u);
+		uc.push_back((unsigned char)r);
+		sc.push_back((signed char)r);
+		s.push_back(std::to_string(r % 997));
+	}
+	d.push_back(-0.0);
+	d.push_back(0.0);
+	d.push_back(1e300);
+	d.push_back(-1e300);
+	Check("double", d);
+	Check("float", f);
+	Check("long double", ld);
+	Check("long long", ll);
+	Check("unsigned", u);
+	Check("unsigned char", uc);
+	Check("signed char", sc);
+	Check("string", s);
+	sjtu::vector<bool> v;
+	int ones = 0;
+	for (int i = 0; i < 1000; ++i) {
+		v.push_back(Next() % 3 == 0);
+		ones += v.back();
+	}
+	sjtu::sort(v.begin(), v.end());
+	bool ok = true;
+	for (int i = 0; i < 1000; ++i) {
+		ok = ok && v[i] == (i >= 1000 - ones);
+	}
+	std::cout << "bool " << ok << std::endl;
+}
+
+void TestStability()
+{
+	std::cout << "Testing stability and keys..." << std::endl;
+	sjtu::vector<Record> a, b;
+	std::vector<Record> ref;
+	for (int i = 0; i < 50000; ++i) {
+		Record r = {(int)(Next() % 1000) - 500, i};
+		a.push_back(r);
+		b.push_back(r);
+		ref.push_back(r);
+	}
+	auto byKey = [](const Record &x, const Record &y) { return x.key < y.key; };
+	std::stable_sort(ref.begin(), ref.end(), byKey);
+	sjtu::stable_sort(a.begin(), a.end(), byKey);
+	sjtu::radix_sort(b.begin(), b.end(), [](const Record &r) { return r.key; });
+	bool stable = true, radix = true;
+	for (size_t i = 0; i < ref.size(); ++i) {
+		stable = stable && a[i].key == ref[i].key && a[i].order == ref[i].order;
+		radix = radix && b[i].key == ref[i].key && b[i].order == ref[i].order;
+	}
+	std::cout << stable << " " << radix << std::endl;
+	sjtu::vector<Record> small;
+	for (int i = 0; i < 20; ++i) {
+		Record r = {i % 3, i};
+		small.push_back(r);
+	}
+	sjtu::radix_sort(small.begin(), small.end(), [](const Record &r) { return -r.key * 0.5; });
+	for (size_t i = 0; i < small.size(); ++i) {
+		std::cout << small[i].key << ":" << small[i].order << " ";
+	}
+	std::cout << std::endl;
+	int raw[] = {5, -3, 9, 0, -3, 7};
+	sjtu::sort(raw, raw + 6);
+	for (int x : raw) {
+		std::cout << x << " ";
+	}
+	std::cout << std::endl;
+}
+
+int main()
+{
+	TestShapes();
+	TestTypes();
+	TestStability();
+	return 0;
+}
@@ -0,0 +1,602 @@
+#ifndef SJTU_GAP_VECTOR_HPP
+#define SJTU_GAP_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu
+{
+/**
+ * a data container with the interface of sjtu::vector that keeps its free
+ * space as a gap at the last edit point instead of at the end.
+ * the buffer holds [0, gapStart) and [gapEnd, capacity); an insert or erase
+ * first moves the gap to its position, which costs the distance from the
+ * previous edit, then fills or widens the gap in O(1). so a run of edits
+ * around one cursor is amortized O(1) each, while push_back keeps the gap at
+ * the end and behaves like sjtu::vector.
+ *
+ * element i lives at i or i+gap length, so access stays O(1) and iterators
+ * are random access. iterators hold an index and stay valid across edits,
+ * though the element they refer to may shift.
+ */
+    template<typename T>
+    class gap_vector
+    {
+    private:
+        T *_data;
+        size_t _capacity;
+        size_t gapStart;
+        size_t gapEnd;
+
+        size_t gapLength() const
+        {
+            return gapEnd-gapStart;
+        }
+
+        T *slot(size_t i) const
+        {
+            return _data+(i<gapStart?i:i+gapLength());
+        }
+
+        /**
+         * move count elements from src to the raw slots at dest one at a
+         * time, walking in the direction that keeps an overlap safe.
+         */
+        static void shift(T *dest, T *src, size_t count, std::true_type)
+        {
+            if(count) std::memmove(static_cast<void *>(dest), static_cast<const void *>(src), count*sizeof(T));
+        }
+
+        static void shift(T *dest, T *src, size_t count, std::false_type)
+        {
+            if(dest<src)
+            {
+                for(size_t i=0;i<count;++i)
+                {
+                    new(dest+i) T(std::move(src[i]));
+                    src[i].~T();
+                }
+            } else
+            {
+                for(size_t i=count;i>0;--i)
+                {
+                    new(dest+i-1) T(std::move(src[i-1]));
+                    src[i-1].~T();
+                }
+            }
+        }
+
+        static void shift(T *dest, T *src, size_t count)
+        {
+            shift(dest, src, count, std::integral_constant<bool, is_trivially_relocatable<T>::value>());
+        }
+
+        /**
+         * slides the gap so that it starts at pos (0 <= pos <= size).
+         */
+        void moveGap(size_t pos)
+        {
+            if(gapStart==gapEnd)
+            {
+                //a full buffer has nothing to move, the gap is only a position
+                gapStart=gapEnd=pos;
+                return;
+            }
+            if(pos<gapStart) shift(_data+pos+gapLength(), _data+pos, gapStart-pos);
+            else if(pos>gapStart) shift(_data+gapStart, _data+gapEnd, pos-gapStart);
+            gapEnd=pos+gapLength();
+            gapStart=pos;
+        }
+
+        /**
+         * reallocates to newCapacity (>= size), keeping the gap where it is.
+         */
+        void reallocate(size_t newCapacity)
+        {
+            T *temp=newCapacity?static_cast<T *>(::operator new(newCapacity*sizeof(T))):nullptr;
+            size_t tail=_capacity-gapEnd;
+            if(temp!=nullptr)
+            {
+                shift(temp, _data, gapStart);
+                shift(temp+newCapacity-tail, _data+gapEnd, tail);
+            }
+            ::operator delete(_data);
+            _data=temp;
+            _capacity=newCapacity;
+            gapEnd=newCapacity-tail;
+        }
+
+        void destroyAll()
+        {
+            for(size_t i=0;i<gapStart;++i)
+                _data[i].~T();
+            for(size_t i=gapEnd;i<_capacity;++i)
+                _data[i].~T();
+            gapStart=0;
+            gapEnd=_capacity;
+        }
+
+        void copyFrom(const gap_vector &other)
+        {
+            size_t n=other.size();
+            if(n>_capacity)
+            {
+                ::operator delete(_data);
+                _data=static_cast<T *>(::operator new(n*sizeof(T)));
+                _capacity=n;
+                gapEnd=n;
+            }
+            //gapStart counts what is constructed, in case a copy throws
+            for(size_t i=0;i<n;++i)
+            {
+                new(_data+i) T(*other.slot(i));
+                gapStart++;
+            }
+        }
+
+        template<typename... Args>
+        void emplaceAt(size_t pos, Args &&...args)
+        {
+            //args may refer to an element that moveGap or reallocate is about to move
+            T value(std::forward<Args>(args)...);
+            moveGap(pos);
+            if(gapStart==gapEnd) reallocate(_capacity?_capacity*2:10);
+            new(_data+gapStart) T(std::move(value));
+            gapStart++;
+        }
+
+        void eraseAt(size_t pos)
+        {
+            moveGap(pos);
+            _data[gapEnd].~T();
+            gapEnd++;
+        }
+
+    public:
+        class const_iterator;
+
+        class iterator
+        {
+            friend class gap_vector;
+
+        private:
+            gap_vector *vec;
+            size_t ptr;
+
+        public:
+            iterator operator+(const int &n) const
+            {
+                iterator it=*this;
+                it.ptr+=n;
+                return it;
+            }
+
+            iterator operator-(const int &n) const
+            {
+                iterator it=*this;
+                it.ptr-=n;
+                return it;
+            }
+
+            // return the distance between two iterators,
+            // if these two iterators point to different vectors, throw invaild_iterator.
+            int operator-(const iterator &rhs) const
+            {
+                if(vec!=rhs.vec) throw invalid_iterator();
+                return ptr-rhs.ptr;
+            }
+
+            iterator &operator+=(const int &n)
+            {
+                ptr+=n;
+                return *this;
+            }
+
+            iterator &operator-=(const int &n)
+            {
+                ptr-=n;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator it=*this;
+                ptr++;
+                return it;
+            }
+
+            iterator &operator++()
+            {
+                ptr++;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                iterator it=*this;
+                ptr--;
+                return it;
+            }
+
+            iterator &operator--()
+            {
+                ptr--;
+                return *this;
+            }
+
+            T &operator*() const
+            {
+                return *vec->slot(ptr);
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+        };
+
+        class const_iterator
+        {
+            friend class gap_vector;
+
+        private:
+            const gap_vector *vec;
+            size_t ptr;
+
+        public:
+            const_iterator operator+(const int &n) const
+            {
+                const_iterator it=*this;
+                it.ptr+=n;
+                return it;
+            }
+
+            const_iterator operator-(const int &n) const
+            {
+                const_iterator it=*this;
+                it.ptr-=n;
+                return it;
+            }
+
+            int operator-(const const_iterator &rhs) const
+            {
+                if(vec!=rhs.vec) throw invalid_iterator();
+                return ptr-rhs.ptr;
+            }
+
+            const_iterator &operator+=(const int &n)
+            {
+                ptr+=n;
+                return *this;
+            }
+
+            const_iterator &operator-=(const int &n)
+            {
+                ptr-=n;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator it=*this;
+                ptr++;
+                return it;
+            }
+
+            const_iterator &operator++()
+            {
+                ptr++;
+                return *this;
+            }
+
+            const_iterator operator--(int)
+            {
+                const_iterator it=*this;
+                ptr--;
+                return it;
+            }
+
+            const_iterator &operator--()
+            {
+                ptr--;
+                return *this;
+            }
+
+            const T &operator*() const
+            {
+                return *vec->slot(ptr);
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+        };
+
+        /**
+         * nothing is allocated until the first element arrives.
+         */
+        gap_vector() : _data(nullptr), _capacity(0), gapStart(0), gapEnd(0)
+        {}
+
+        gap_vector(const gap_vector &other) : _data(nullptr), _capacity(0), gapStart(0), gapEnd(0)
+        {
+            try
+            {
+                copyFrom(other);
+            } catch(...)
+            {
+                destroyAll();
+                ::operator delete(_data);
+                throw;
+            }
+        }
+
+        gap_vector(gap_vector &&other) noexcept
+                : _data(other._data), _capacity(other._capacity), gapStart(other.gapStart), gapEnd(other.gapEnd)
+        {
+            other._data=nullptr;
+            other._capacity=other.gapStart=other.gapEnd=0;
+        }
+
+        ~gap_vector()
+        {
+            destroyAll();
+            ::operator delete(_data);
+        }
+
+        gap_vector &operator=(const gap_vector &other)
+        {
+            if(this==&other) return *this;
+            destroyAll();
+            copyFrom(other);
+            return *this;
+        }
+
+        gap_vector &operator=(gap_vector &&other) noexcept
+        {
+            if(this==&other) return *this;
+            destroyAll();
+            ::operator delete(_data);
+            _data=other._data;
+            _capacity=other._capacity;
+            gapStart=other.gapStart;
+            gapEnd=other.gapEnd;
+            other._data=nullptr;
+            other._capacity=other.gapStart=other.gapEnd=0;
+            return *this;
+        }
+
+        /**
+         * access specified element with bounds checking
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        T &at(const size_t &pos)
+        {
+            if(pos>=size()) throw index_out_of_bound();
+            return *slot(pos);
+        }
+
+        const T &at(const size_t &pos) const
+        {
+            if(pos>=size()) throw index_out_of_bound();
+            return *slot(pos);
+        }
+
+        T &operator[](const size_t &pos)
+        {
+            return at(pos);
+        }
+
+        const T &operator[](const size_t &pos) const
+        {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        const T &front() const
+        {
+            if(empty()) throw container_is_empty();
+            return *slot(0);
+        }
+
+        const T &back() const
+        {
+            if(empty()) throw container_is_empty();
+            return *slot(size()-1);
+        }
+
+        iterator begin()
+        {
+            iterator it;
+            it.vec=this;
+            it.ptr=0;
+            return it;
+        }
+
+        const_iterator cbegin() const
+        {
+            const_iterator it;
+            it.vec=this;
+            it.ptr=0;
+            return it;
+        }
+
+        iterator end()
+        {
+            iterator it;
+            it.vec=this;
+            it.ptr=size();
+            return it;
+        }
+
+        const_iterator cend() const
+        {
+            const_iterator it;
+            it.vec=this;
+            it.ptr=size();
+            return it;
+        }
+
+        bool empty() const
+        {
+            return size()==0;
+        }
+
+        size_t size() const
+        {
+            return _capacity-gapLength();
+        }
+
+        size_t capacity() const
+        {
+            return _capacity;
+        }
+
+        /**
+         * where the gap currently starts, i.e. the index the next edit
+         * can use without moving anything.
+         */
+        size_t gap_position() const
+        {
+            return gapStart;
+        }
+
+        /**
+         * clears the contents, keeping the buffer for reuse.
+         */
+        void clear()
+        {
+            destroyAll();
+        }
+
+        void reserve(size_t n)
+        {
+            if(n>_capacity) reallocate(n);
+        }
+
+        void shrink_to_fit()
+        {
+            if(size()<_capacity) reallocate(size());
+        }
+
+        /**
+         * inserts value before pos
+         * returns an iterator pointing to the inserted value.
+         */
+        iterator insert(iterator pos, const T &value)
+        {
+            emplaceAt(pos.ptr, value);
+            return pos;
+        }
+
+        iterator insert(iterator pos, T &&value)
+        {
+            emplaceAt(pos.ptr, std::move(value));
+            return pos;
+        }
+
+        /**
+         * throw index_out_of_bound if ind > size
+         */
+        iterator insert(const size_t &ind, const T &value)
+        {
+            if(ind>size()) throw index_out_of_bound();
+            emplaceAt(ind, value);
+            return begin()+ind;
+        }
+
+        template<typename... Args>
+        iterator emplace(iterator pos, Args &&...args)
+        {
+            emplaceAt(pos.ptr, std::forward<Args>(args)...);
+            return pos;
+        }
+
+        /**
+         * removes the element at pos.
+         * return an iterator pointing to the following element.
+         */
+        iterator erase(iterator pos)
+        {
+            eraseAt(pos.ptr);
+            return pos;
+        }
+
+        /**
+         * throw index_out_of_bound if ind >= size
+         */
+        iterator erase(const size_t &ind)
+        {
+            if(ind>=size()) throw index_out_of_bound();
+            eraseAt(ind);
+            return begin()+ind;
+        }
+
+        void push_back(const T &value)
+        {
+            emplaceAt(size(), value);
+        }
+
+        void push_back(T &&value)
+        {
+            emplaceAt(size(), std::move(value));
+        }
+
+        template<typename... Args>
+        T &emplace_back(Args &&...args)
+        {
+            emplaceAt(size(), std::forward<Args>(args)...);
+            return _data[gapStart-1];
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_back()
+        {
+            if(empty()) throw container_is_empty();
+            eraseAt(size()-1);
+        }
+    };
+}
+
+#endif
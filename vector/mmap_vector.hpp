@@ -0,0 +1,348 @@
+#ifndef SJTU_MMAP_VECTOR_HPP
+#define SJTU_MMAP_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace sjtu
+{
+/**
+ * a vector of trivially copyable records that lives in a file.
+ * the file is mapped into memory, so opening an existing dataset costs
+ * no copy and no parsing; pages are read in lazily by the kernel.
+ *
+ * file layout: a 64-byte header (magic, element size, element count)
+ * followed by the elements. the file is grown with ftruncate + mremap
+ * and trimmed to the used size when the vector is closed.
+ *
+ * system call failures throw runtime_error.
+ * iterators are plain pointers and are invalidated by growth.
+ */
+    template<typename T>
+    class mmap_vector
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "mmap_vector only holds trivially copyable types");
+
+    public:
+        typedef T *iterator;
+        typedef const T *const_iterator;
+
+    private:
+        struct header
+        {
+            char magic[8];
+            uint64_t elementSize;
+            uint64_t size;
+        };
+
+        static const size_t HEADER_SIZE=64;
+        static const size_t MIN_CAPACITY=1024;
+
+        int fd;
+        char *base;
+        size_t mapped;
+        size_t _capacity;
+
+        header *head() const
+        {
+            return reinterpret_cast<header *>(base);
+        }
+
+        T *elements() const
+        {
+            return reinterpret_cast<T *>(base+HEADER_SIZE);
+        }
+
+        static size_t bytesFor(size_t n)
+        {
+            return HEADER_SIZE+n*sizeof(T);
+        }
+
+        /**
+         * resize the file and the mapping to hold n elements.
+         */
+        void remap(size_t n)
+        {
+            size_t bytes=bytesFor(n);
+            if(ftruncate(fd, bytes)!=0) throw runtime_error();
+            void *p=mremap(base, mapped, bytes, MREMAP_MAYMOVE);
+            if(p==MAP_FAILED) throw runtime_error();
+            base=static_cast<char *>(p);
+            mapped=bytes;
+            _capacity=n;
+        }
+
+        void grow(size_t required)
+        {
+            size_t newCapacity=_capacity*2;
+            if(newCapacity<required) newCapacity=required;
+            remap(newCapacity);
+        }
+
+        void close()
+        {
+            if(base==nullptr) return;
+            size_t used=bytesFor(head()->size);
+            munmap(base, mapped);
+            //on failure the file just keeps its spare capacity
+            if(ftruncate(fd, used)!=0) {}
+            ::close(fd);
+            base=nullptr;
+            fd=-1;
+        }
+
+    public:
+        /**
+         * opens the dataset at path, creating an empty one if it does not exist.
+         * throw runtime_error if the file cannot be mapped or holds another type.
+         */
+        explicit mmap_vector(const char *path)
+        {
+            fd=open(path, O_RDWR|O_CREAT, 0644);
+            if(fd<0) throw runtime_error();
+            struct stat st;
+            if(fstat(fd, &st)!=0)
+            {
+                ::close(fd);
+                throw runtime_error();
+            }
+            size_t fileSize=st.st_size;
+            bool fresh=fileSize==0;
+            if(fresh) fileSize=bytesFor(MIN_CAPACITY);
+            else if(fileSize<HEADER_SIZE||(fileSize-HEADER_SIZE)%sizeof(T)!=0)
+            {
+                ::close(fd);
+                throw runtime_error();
+            }
+            if(fresh&&ftruncate(fd, fileSize)!=0)
+            {
+                ::close(fd);
+                throw runtime_error();
+            }
+            void *p=mmap(nullptr, fileSize, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+            if(p==MAP_FAILED)
+            {
+                ::close(fd);
+                throw runtime_error();
+            }
+            base=static_cast<char *>(p);
+            mapped=fileSize;
+            _capacity=(fileSize-HEADER_SIZE)/sizeof(T);
+            if(fresh)
+            {
+                std::memcpy(head()->magic, "SJTUMMV1", 8);
+                head()->elementSize=sizeof(T);
+                head()->size=0;
+            } else if(std::memcmp(head()->magic, "SJTUMMV1", 8)!=0||head()->elementSize!=sizeof(T)||head()->size>_capacity)
+            {
+                munmap(base, mapped);
+                ::close(fd);
+                base=nullptr;
+                throw runtime_error();
+            }
+        }
+
+        mmap_vector(const mmap_vector &)=delete;
+
+        mmap_vector &operator=(const mmap_vector &)=delete;
+
+        mmap_vector(mmap_vector &&other) noexcept
+                : fd(other.fd), base(other.base), mapped(other.mapped), _capacity(other._capacity)
+        {
+            other.fd=-1;
+            other.base=nullptr;
+        }
+
+        mmap_vector &operator=(mmap_vector &&other) noexcept
+        {
+            if(this==&other) return *this;
+            close();
+            fd=other.fd;
+            base=other.base;
+            mapped=other.mapped;
+            _capacity=other._capacity;
+            other.fd=-1;
+            other.base=nullptr;
+            return *this;
+        }
+
+        /**
+         * unmaps the file and trims it to the elements in use.
+         */
+        ~mmap_vector()
+        {
+            close();
+        }
+
+        /**
+         * access specified element with bounds checking
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        T &at(const size_t &pos)
+        {
+            if(pos>=size()) throw index_out_of_bound();
+            return elements()[pos];
+        }
+
+        const T &at(const size_t &pos) const
+        {
+            if(pos>=size()) throw index_out_of_bound();
+            return elements()[pos];
+        }
+
+        T &operator[](const size_t &pos)
+        {
+            return at(pos);
+        }
+
+        const T &operator[](const size_t &pos) const
+        {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        const T &front() const
+        {
+            if(empty()) throw container_is_empty();
+            return elements()[0];
+        }
+
+        const T &back() const
+        {
+            if(empty()) throw container_is_empty();
+            return elements()[size()-1];
+        }
+
+        T *data()
+        {
+            return elements();
+        }
+
+        const T *data() const
+        {
+            return elements();
+        }
+
+        iterator begin()
+        {
+            return elements();
+        }
+
+        const_iterator cbegin() const
+        {
+            return elements();
+        }
+
+        iterator end()
+        {
+            return elements()+size();
+        }
+
+        const_iterator cend() const
+        {
+            return elements()+size();
+        }
+
+        bool empty() const
+        {
+            return size()==0;
+        }
+
+        size_t size() const
+        {
+            return head()->size;
+        }
+
+        size_t capacity() const
+        {
+            return _capacity;
+        }
+
+        /**
+         * clears the contents, the file keeps its capacity.
+         */
+        void clear()
+        {
+            head()->size=0;
+        }
+
+        void reserve(size_t n)
+        {
+            if(n>_capacity) remap(n);
+        }
+
+        /**
+         * new elements are zero-filled.
+         */
+        void resize(size_t n)
+        {
+            size_t old=size();
+            if(n>_capacity) remap(n);
+            if(n>old) std::memset(static_cast<void *>(elements()+old), 0, (n-old)*sizeof(T));
+            head()->size=n;
+        }
+
+        void push_back(const T &value)
+        {
+            size_t n=size();
+            if(n==_capacity)
+            {
+                T copy=value;
+                grow(n+1);
+                elements()[n]=copy;
+            } else elements()[n]=value;
+            head()->size=n+1;
+        }
+
+        /**
+         * adds the n records starting at ptr to the end with one memcpy.
+         */
+        void append(const T *ptr, size_t n)
+        {
+            size_t old=size();
+            if(old+n>_capacity)
+            {
+                //ptr may point into the mapping that grow() is about to move
+                if(ptr>=elements()&&ptr<elements()+old)
+                {
+                    size_t offset=ptr-elements();
+                    grow(old+n);
+                    ptr=elements()+offset;
+                } else grow(old+n);
+            }
+            std::memcpy(static_cast<void *>(elements()+old), static_cast<const void *>(ptr), n*sizeof(T));
+            head()->size=old+n;
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_back()
+        {
+            if(empty()) throw container_is_empty();
+            head()->size--;
+        }
+
+        /**
+         * flushes dirty pages to the file and waits for the write to finish.
+         * throw runtime_error on failure.
+         */
+        void sync()
+        {
+            if(msync(base, mapped, MS_SYNC)!=0) throw runtime_error();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,471 @@
+#ifndef SJTU_PARALLEL_HPP
+#define SJTU_PARALLEL_HPP
+
+#include "sort.hpp"
+#include "vector.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu
+{
+/**
+ * execution policies of the algorithms below.
+ * seq runs on the calling thread, par splits the range over thread_pool::instance().
+ */
+    struct sequenced_policy
+    {};
+
+    struct parallel_policy
+    {};
+
+    constexpr sequenced_policy seq{};
+    constexpr parallel_policy par{};
+
+/**
+ * a fixed set of worker threads, each with its own task deque.
+ * a worker runs its newest task first and, when it has none, steals the
+ * oldest task of another worker. a thread waiting for its tasks keeps
+ * running queued tasks instead of blocking, so nested fork-join (as in
+ * the parallel merge sort) cannot deadlock the pool.
+ */
+    class thread_pool
+    {
+    public:
+        typedef std::function<void()> task;
+
+    private:
+        struct queue
+        {
+            std::mutex lock;
+            std::deque<task> tasks;
+        };
+
+        size_t count;
+        queue *queues;
+        vector<std::thread> threads;
+        std::atomic<size_t> pending;
+        std::atomic<size_t> next;
+        std::mutex sleepLock;
+        std::condition_variable wake;
+        bool stop;
+
+        /**
+         * the pool the current thread works for and its queue index.
+         */
+        static thread_pool *&currentPool()
+        {
+            static thread_local thread_pool *pool=nullptr;
+            return pool;
+        }
+
+        static size_t &currentIndex()
+        {
+            static thread_local size_t index=0;
+            return index;
+        }
+
+        bool popLocal(size_t i, task &t)
+        {
+            std::lock_guard<std::mutex> guard(queues[i].lock);
+            if(queues[i].tasks.empty()) return false;
+            t=std::move(queues[i].tasks.back());
+            queues[i].tasks.pop_back();
+            return true;
+        }
+
+        bool steal(size_t i, task &t)
+        {
+            std::lock_guard<std::mutex> guard(queues[i].lock);
+            if(queues[i].tasks.empty()) return false;
+            t=std::move(queues[i].tasks.front());
+            queues[i].tasks.pop_front();
+            return true;
+        }
+
+        /**
+         * run one queued task, preferring the caller's own queue.
+         * returns false if every queue was empty.
+         */
+        bool runOne()
+        {
+            task t;
+            bool worker=currentPool()==this;
+            size_t self=worker?currentIndex():next.load(std::memory_order_relaxed)%count;
+            bool found=worker&&popLocal(self, t);
+            for(size_t k=0;!found&&k<count;++k)
+                found=steal((self+k)%count, t);
+            if(!found) return false;
+            pending.fetch_sub(1);
+            t();
+            return true;
+        }
+
+        void work(size_t index)
+        {
+            currentPool()=this;
+            currentIndex()=index;
+            while(true)
+            {
+                if(runOne()) continue;
+                std::unique_lock<std::mutex> guard(sleepLock);
+                wake.wait(guard, [this]{ return stop||pending.load()>0; });
+                if(stop&&pending.load()==0) return;
+            }
+        }
+
+    public:
+        /**
+         * starts n workers, one per hardware thread when n is 0.
+         */
+        explicit thread_pool(size_t n=0) : pending(0), next(0), stop(false)
+        {
+            if(n==0) n=std::thread::hardware_concurrency();
+            if(n==0) n=1;
+            count=n;
+            queues=new queue[count];
+            threads.reserve(count);
+            for(size_t i=0;i<count;++i)
+                threads.emplace_back(&thread_pool::work, this, i);
+        }
+
+        thread_pool(const thread_pool &)=delete;
+
+        thread_pool &operator=(const thread_pool &)=delete;
+
+        /**
+         * finishes the queued tasks and joins the workers.
+         */
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                stop=true;
+            }
+            wake.notify_all();
+            for(size_t i=0;i<count;++i)
+                threads[i].join();
+            delete[] queues;
+        }
+
+        /**
+         * the shared pool used by the parallel_policy algorithms.
+         */
+        static thread_pool &instance()
+        {
+            static thread_pool pool;
+            return pool;
+        }
+
+        size_t size() const
+        {
+            return count;
+        }
+
+        /**
+         * queues t, on the caller's own deque when it is a worker of this pool.
+         */
+        void submit(task t)
+        {
+            size_t i=currentPool()==this?currentIndex():next.fetch_add(1)%count;
+            //counted before it is visible, so a thief can never take pending below zero
+            {
+                std::lock_guard<std::mutex> guard(sleepLock);
+                pending.fetch_add(1);
+            }
+            {
+                std::lock_guard<std::mutex> guard(queues[i].lock);
+                queues[i].tasks.push_back(std::move(t));
+            }
+            wake.notify_one();
+        }
+
+        /**
+         * runs queued tasks until remaining drops to zero.
+         */
+        void wait(const std::atomic<size_t> &remaining)
+        {
+            while(remaining.load()!=0)
+                if(!runOne()) std::this_thread::yield();
+        }
+
+        /**
+         * calls f(begin, end) on consecutive chunks of [0, n) in parallel
+         * and returns when all of them are done. chunks hold at least grain indices.
+         */
+        template<typename F>
+        void parallel_for(size_t n, size_t grain, const F &f)
+        {
+            if(grain==0) grain=1;
+            size_t chunks=n/grain;
+            if(chunks>count*4) chunks=count*4;
+            if(chunks<=1)
+            {
+                if(n) f(size_t(0), n);
+                return;
+            }
+            std::atomic<size_t> remaining(chunks-1);
+            for(size_t c=1;c<chunks;++c)
+            {
+                size_t begin=n*c/chunks, end=n*(c+1)/chunks;
+                submit([&f, &remaining, begin, end]{
+                    f(begin, end);
+                    remaining.fetch_sub(1);
+                });
+            }
+            f(size_t(0), n/chunks);
+            wait(remaining);
+        }
+    };
+
+    namespace detail
+    {
+        const size_t PARALLEL_GRAIN=4096;
+
+        /**
+         * merge sort a[0, n) using tmp[0, n) as scratch space.
+         * the halves are sorted as separate pool tasks down to PARALLEL_GRAIN.
+         */
+        template<typename T, typename Compare>
+        void mergeSort(thread_pool *pool, T *a, T *tmp, size_t n, Compare comp)
+        {
+            if(n<=32)
+            {
+                insertionSort(a, n, comp);
+                return;
+            }
+            size_t mid=n/2;
+            if(pool!=nullptr&&n>PARALLEL_GRAIN)
+            {
+                std::atomic<size_t> remaining(1);
+                pool->submit([=, &remaining]{
+                    mergeSort(pool, a, tmp, mid, comp);
+                    remaining.fetch_sub(1);
+                });
+                mergeSort(pool, a+mid, tmp+mid, n-mid, comp);
+                pool->wait(remaining);
+            } else
+            {
+                mergeSort(pool, a, tmp, mid, comp);
+                mergeSort(pool, a+mid, tmp+mid, n-mid, comp);
+            }
+            if(!comp(a[mid], a[mid-1])) return;
+            merge(a, tmp, mid, n, comp);
+        }
+
+        template<typename It, typename Compare>
+        void sort(thread_pool *pool, It first, It last, Compare comp)
+        {
+            size_t n=last-first;
+            if(n<2) return;
+            typedef typename value_of<It>::type T;
+            T *a=&*first;
+            vector<T> tmp;
+            tmp.append(a, n);
+            mergeSort(pool, a, tmp.data(), n, comp);
+        }
+    }
+
+/**
+ * for_each: calls f on every element of [first, last).
+ */
+    template<typename It, typename F>
+    void for_each(sequenced_policy, It first, It last, F f)
+    {
+        for(;first!=last;++first)
+            f(*first);
+    }
+
+    template<typename It, typename F>
+    void for_each(parallel_policy, It first, It last, F f)
+    {
+        thread_pool::instance().parallel_for(last-first, detail::PARALLEL_GRAIN, [&](size_t begin, size_t end){
+            It it=first+begin;
+            for(size_t i=begin;i<end;++i,++it)
+                f(*it);
+        });
+    }
+
+/**
+ * transform: writes op(x) for every x in [first, last) to the range at d_first.
+ * returns the end of the written range.
+ */
+    template<typename It, typename OutIt, typename Op>
+    OutIt transform(sequenced_policy, It first, It last, OutIt d_first, Op op)
+    {
+        for(;first!=last;++first,++d_first)
+            *d_first=op(*first);
+        return d_first;
+    }
+
+    template<typename It, typename OutIt, typename Op>
+    OutIt transform(parallel_policy, It first, It last, OutIt d_first, Op op)
+    {
+        size_t n=last-first;
+        thread_pool::instance().parallel_for(n, detail::PARALLEL_GRAIN, [&](size_t begin, size_t end){
+            It it=first+begin;
+            OutIt out=d_first+begin;
+            for(size_t i=begin;i<end;++i,++it,++out)
+                *out=op(*it);
+        });
+        return d_first+n;
+    }
+
+/**
+ * reduce: combines init and every element of [first, last) with op.
+ * the parallel version regroups the operands, so op must be associative.
+ */
+    template<typename It, typename T, typename Op>
+    T reduce(sequenced_policy, It first, It last, T init, Op op)
+    {
+        for(;first!=last;++first)
+            init=op(init, *first);
+        return init;
+    }
+
+    template<typename It, typename T>
+    T reduce(sequenced_policy policy, It first, It last, T init)
+    {
+        return reduce(policy, first, last, init, std::plus<T>());
+    }
+
+    template<typename It, typename T, typename Op>
+    T reduce(parallel_policy, It first, It last, T init, Op op)
+    {
+        thread_pool &pool=thread_pool::instance();
+        size_t n=last-first;
+        size_t chunks=n/detail::PARALLEL_GRAIN;
+        if(chunks>pool.size()*4) chunks=pool.size()*4;
+        if(chunks<=1) return reduce(seq, first, last, init, op);
+        vector<T> partial;
+        partial.resize(chunks, init);
+        pool.parallel_for(chunks, 1, [&](size_t begin, size_t end){
+            for(size_t c=begin;c<end;++c)
+            {
+                It it=first+n*c/chunks, stop=first+n*(c+1)/chunks;
+                T sum=*it;
+                for(++it;it!=stop;++it)
+                    sum=op(sum, *it);
+                partial[c]=sum;
+            }
+        });
+        for(size_t c=0;c<chunks;++c)
+            init=op(init, partial[c]);
+        return init;
+    }
+
+    template<typename It, typename T>
+    T reduce(parallel_policy policy, It first, It last, T init)
+    {
+        return reduce(policy, first, last, init, std::plus<T>());
+    }
+
+/**
+ * inclusive_scan: writes the running op-sums of [first, last) to d_first.
+ * the parallel version sums each chunk, scans the chunk sums, then
+ * rescans every chunk from its offset. op must be associative.
+ */
+    template<typename It, typename OutIt, typename Op>
+    OutIt inclusive_scan(sequenced_policy, It first, It last, OutIt d_first, Op op)
+    {
+        if(first==last) return d_first;
+        typename detail::value_of<It>::type sum=*first;
+        *d_first=sum;
+        for(++first,++d_first;first!=last;++first,++d_first)
+        {
+            sum=op(sum, *first);
+            *d_first=sum;
+        }
+        return d_first;
+    }
+
+    template<typename It, typename OutIt>
+    OutIt inclusive_scan(sequenced_policy policy, It first, It last, OutIt d_first)
+    {
+        return inclusive_scan(policy, first, last, d_first, std::plus<typename detail::value_of<It>::type>());
+    }
+
+    template<typename It, typename OutIt, typename Op>
+    OutIt inclusive_scan(parallel_policy, It first, It last, OutIt d_first, Op op)
+    {
+        typedef typename detail::value_of<It>::type T;
+        thread_pool &pool=thread_pool::instance();
+        size_t n=last-first;
+        size_t chunks=n/detail::PARALLEL_GRAIN;
+        if(chunks>pool.size()*4) chunks=pool.size()*4;
+        if(chunks<=1) return inclusive_scan(seq, first, last, d_first, op);
+        vector<T> sums;
+        sums.resize(chunks, *first);
+        pool.parallel_for(chunks, 1, [&](size_t begin, size_t end){
+            for(size_t c=begin;c<end;++c)
+            {
+                It it=first+n*c/chunks, stop=first+n*(c+1)/chunks;
+                T sum=*it;
+                for(++it;it!=stop;++it)
+                    sum=op(sum, *it);
+                sums[c]=sum;
+            }
+        });
+        for(size_t c=1;c<chunks;++c)
+            sums[c]=op(sums[c-1], sums[c]);
+        pool.parallel_for(chunks, 1, [&](size_t begin, size_t end){
+            for(size_t c=begin;c<end;++c)
+            {
+                size_t from=n*c/chunks, to=n*(c+1)/chunks;
+                It it=first+from;
+                OutIt out=d_first+from;
+                T sum=c?op(sums[c-1], *it):*it;
+                *out=sum;
+                for(++it,++out,++from;from<to;++it,++out,++from)
+                {
+                    sum=op(sum, *it);
+                    *out=sum;
+                }
+            }
+        });
+        return d_first+n;
+    }
+
+    template<typename It, typename OutIt>
+    OutIt inclusive_scan(parallel_policy policy, It first, It last, OutIt d_first)
+    {
+        return inclusive_scan(policy, first, last, d_first, std::plus<typename detail::value_of<It>::type>());
+    }
+
+/**
+ * sort: stable merge sort of [first, last), which must be contiguous
+ * (sjtu::vector iterators or pointers). uses a scratch copy of the range.
+ */
+    template<typename It, typename Compare>
+    void sort(sequenced_policy, It first, It last, Compare comp)
+    {
+        detail::sort(nullptr, first, last, comp);
+    }
+
+    template<typename It>
+    void sort(sequenced_policy policy, It first, It last)
+    {
+        sort(policy, first, last, std::less<typename detail::value_of<It>::type>());
+    }
+
+    template<typename It, typename Compare>
+    void sort(parallel_policy, It first, It last, Compare comp)
+    {
+        detail::sort(&thread_pool::instance(), first, last, comp);
+    }
+
+    template<typename It>
+    void sort(parallel_policy policy, It first, It last)
+    {
+        sort(policy, first, last, std::less<typename detail::value_of<It>::type>());
+    }
+}
+
+#endif
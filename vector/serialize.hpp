@@ -0,0 +1,248 @@
+#ifndef SJTU_SERIALIZE_HPP
+#define SJTU_SERIALIZE_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu
+{
+/**
+ * binary save and load of sjtu::vector, to a FILE* or to a byte buffer.
+ *
+ * a saved vector is a 24-byte header (magic, format version, element size,
+ * element count) followed by the elements. trivially copyable elements are
+ * written and read as one block, so a checkpoint runs at the speed of the
+ * file; any other T is written element by element through serializer<T>,
+ * which the user specializes. the header records element size 0 for those.
+ *
+ * the format uses the byte order and layout of the machine that wrote it.
+ * short reads, short writes and headers that do not match throw
+ * runtime_error; the vector being loaded is left empty then.
+ */
+    const uint32_t SERIALIZE_VERSION=1;
+
+    /**
+     * where save writes its bytes: a FILE* or the end of a byte buffer.
+     */
+    class writer
+    {
+    private:
+        std::FILE *file;
+        vector<char> *buffer;
+
+    public:
+        explicit writer(std::FILE *file) : file(file), buffer(nullptr)
+        {}
+
+        explicit writer(vector<char> &buffer) : file(nullptr), buffer(&buffer)
+        {}
+
+        void write(const void *data, size_t n)
+        {
+            if(n==0) return;
+            if(file==nullptr) buffer->append(static_cast<const char *>(data), n);
+            else if(std::fwrite(data, 1, n, file)!=n) throw runtime_error();
+        }
+
+        template<typename U>
+        void write(const U &value)
+        {
+            static_assert(std::is_trivially_copyable<U>::value, "write(value) takes trivially copyable values");
+            write(&value, sizeof(U));
+        }
+    };
+
+    /**
+     * where load reads its bytes: a FILE* or a byte buffer.
+     */
+    class reader
+    {
+    private:
+        std::FILE *file;
+        const char *pos;
+        const char *end;
+
+    public:
+        explicit reader(std::FILE *file) : file(file), pos(nullptr), end(nullptr)
+        {}
+
+        reader(const char *data, size_t n) : file(nullptr), pos(data), end(data+n)
+        {}
+
+        void read(void *data, size_t n)
+        {
+            if(n==0) return;
+            if(file!=nullptr)
+            {
+                if(std::fread(data, 1, n, file)!=n) throw runtime_error();
+                return;
+            }
+            if(n>remaining()) throw runtime_error();
+            std::memcpy(data, pos, n);
+            pos+=n;
+        }
+
+        template<typename U>
+        U read()
+        {
+            static_assert(std::is_trivially_copyable<U>::value, "read<U>() takes trivially copyable values");
+            U value;
+            read(&value, sizeof(U));
+            return value;
+        }
+
+        /**
+         * bytes left in a buffer; unknown (the maximum) for a file.
+         */
+        size_t remaining() const
+        {
+            return file==nullptr?size_t(end-pos):size_t(-1);
+        }
+
+        const char *position() const
+        {
+            return pos;
+        }
+    };
+
+    /**
+     * the hook for elements that are not trivially copyable. specialize it as
+     *
+     *     template<> struct serializer<X>
+     *     {
+     *         static void write(writer &out, const X &value);
+     *         static X read(reader &in);
+     *     };
+     *
+     * read returns the element that write stored.
+     */
+    template<typename T>
+    struct serializer;
+
+    namespace detail
+    {
+        struct serialize_header
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t elementSize;
+            uint64_t size;
+        };
+
+        const char SERIALIZE_MAGIC[8]={'S', 'J', 'T', 'U', 'V', 'E', 'C', '\0'};
+
+        template<typename T>
+        uint32_t elementSize()
+        {
+            return std::is_trivially_copyable<T>::value?uint32_t(sizeof(T)):0;
+        }
+
+        template<typename T, typename Growth, typename Alloc, typename Size>
+        void saveElements(const vector<T, Growth, Alloc, Size> &v, writer &out, std::true_type)
+        {
+            out.write(v.data(), v.size()*sizeof(T));
+        }
+
+        template<typename T, typename Growth, typename Alloc, typename Size>
+        void saveElements(const vector<T, Growth, Alloc, Size> &v, writer &out, std::false_type)
+        {
+            for(size_t i=0;i<v.size();++i)
+                serializer<T>::write(out, v[i]);
+        }
+
+        template<typename T, typename Growth, typename Alloc, typename Size>
+        void loadElements(vector<T, Growth, Alloc, Size> &v, reader &in, size_t n, std::true_type)
+        {
+            if(n>in.remaining()/sizeof(T)) throw runtime_error();
+            v.reserve(n);
+            v.resize(n, default_init);
+            in.read(v.data(), n*sizeof(T));
+        }
+
+        template<typename T, typename Growth, typename Alloc, typename Size>
+        void loadElements(vector<T, Growth, Alloc, Size> &v, reader &in, size_t n, std::false_type)
+        {
+            if(n<=in.remaining()) v.reserve(n);
+            for(size_t i=0;i<n;++i)
+                v.push_back(serializer<T>::read(in));
+        }
+    }
+
+    template<typename T, typename Growth, typename Alloc, typename Size>
+    void save(const vector<T, Growth, Alloc, Size> &v, writer &out)
+    {
+        detail::serialize_header head;
+        std::memcpy(head.magic, detail::SERIALIZE_MAGIC, sizeof(head.magic));
+        head.version=SERIALIZE_VERSION;
+        head.elementSize=detail::elementSize<T>();
+        head.size=v.size();
+        out.write(head);
+        detail::saveElements(v, out, std::is_trivially_copyable<T>());
+    }
+
+    /**
+     * replaces the contents of v with the vector stored at in.
+     */
+    template<typename T, typename Growth, typename Alloc, typename Size>
+    void load(vector<T, Growth, Alloc, Size> &v, reader &in)
+    {
+        v.clear();
+        detail::serialize_header head=in.read<detail::serialize_header>();
+        if(std::memcmp(head.magic, detail::SERIALIZE_MAGIC, sizeof(head.magic))!=0) throw runtime_error();
+        if(head.version==0||head.version>SERIALIZE_VERSION) throw runtime_error();
+        if(head.elementSize!=detail::elementSize<T>()) throw runtime_error();
+        try
+        {
+            detail::loadElements(v, in, head.size, std::is_trivially_copyable<T>());
+        } catch(...)
+        {
+            v.clear();
+            throw;
+        }
+    }
+
+    template<typename T, typename Growth, typename Alloc, typename Size>
+    void save(const vector<T, Growth, Alloc, Size> &v, std::FILE *file)
+    {
+        writer out(file);
+        save(v, out);
+    }
+
+    template<typename T, typename Growth, typename Alloc, typename Size>
+    void load(vector<T, Growth, Alloc, Size> &v, std::FILE *file)
+    {
+        reader in(file);
+        load(v, in);
+    }
+
+    /**
+     * appends v to buffer, so several vectors can share one buffer.
+     */
+    template<typename T, typename Growth, typename Alloc, typename Size>
+    void save(const vector<T, Growth, Alloc, Size> &v, vector<char> &buffer)
+    {
+        writer out(buffer);
+        save(v, out);
+    }
+
+    /**
+     * loads the vector stored at the start of [data, data+n).
+     * returns the number of bytes it took up.
+     */
+    template<typename T, typename Growth, typename Alloc, typename Size>
+    size_t load(vector<T, Growth, Alloc, Size> &v, const char *data, size_t n)
+    {
+        reader in(data, n);
+        load(v, in);
+        return in.position()-data;
+    }
+}
+
+#endif
@@ -0,0 +1,667 @@
+#ifndef SJTU_SIMD_HPP
+#define SJTU_SIMD_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && defined(__SSE2__)
+#define SJTU_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace sjtu
+{
+/**
+ * vectorized scans over contiguous arithmetic data.
+ *
+ * int, long long and double have SSE2 and AVX2 kernels; the best level the
+ * cpu supports is detected once at run time. every other type, and every
+ * non-x86 build, uses the plain loops. integer sums wrap like unsigned
+ * arithmetic, double sums are added in a different order than a plain
+ * loop, and NaNs are not supported by min/max.
+ */
+    namespace simd
+    {
+        enum level
+        {
+            SCALAR, SSE2, AVX2
+        };
+
+        inline level detect()
+        {
+#ifdef SJTU_SIMD_X86
+            __builtin_cpu_init();
+            if(__builtin_cpu_supports("avx2")) return AVX2;
+            return SSE2;
+#else
+            return SCALAR;
+#endif
+        }
+
+        inline level &currentLevel()
+        {
+            static level l=detect();
+            return l;
+        }
+
+        /**
+         * the instruction set the kernels use.
+         */
+        inline level active()
+        {
+            return currentLevel();
+        }
+
+        /**
+         * restricts the kernels to at most l, e.g. to compare against the scalar path.
+         * returns the level actually used.
+         */
+        inline level limit(level l)
+        {
+            level best=detect();
+            currentLevel()=l<best?l:best;
+            return currentLevel();
+        }
+
+        /**
+         * the plain loops.
+         */
+        template<typename T>
+        struct scalar
+        {
+            static const T *find(const T *first, const T *last, T value)
+            {
+                for(;first!=last;++first)
+                    if(*first==value) return first;
+                return last;
+            }
+
+            static size_t count(const T *first, const T *last, T value)
+            {
+                size_t n=0;
+                for(;first!=last;++first)
+                    if(*first==value) n++;
+                return n;
+            }
+
+            static T sum(const T *first, const T *last)
+            {
+                T s=T();
+                for(;first!=last;++first)
+                    s+=*first;
+                return s;
+            }
+
+            static const T *min_element(const T *first, const T *last)
+            {
+                const T *best=first;
+                for(;first!=last;++first)
+                    if(*first<*best) best=first;
+                return best;
+            }
+
+            static const T *max_element(const T *first, const T *last)
+            {
+                const T *best=first;
+                for(;first!=last;++first)
+                    if(*best<*first) best=first;
+                return best;
+            }
+        };
+
+        /**
+         * the kernels used for T; the plain loops unless specialized below.
+         */
+        template<typename T>
+        struct kernels : scalar<T>
+        {};
+
+#ifdef SJTU_SIMD_X86
+        namespace detail
+        {
+#define SJTU_AVX2 __attribute__((target("avx2")))
+
+            inline size_t lowBit(unsigned int mask)
+            {
+                return __builtin_ctz(mask);
+            }
+
+            // int: 4 lanes in SSE2, 8 lanes in AVX2
+
+            inline __m128i min32(__m128i a, __m128i b)
+            {
+                __m128i gt=_mm_cmpgt_epi32(a, b);
+                return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a));
+            }
+
+            inline __m128i max32(__m128i a, __m128i b)
+            {
+                __m128i gt=_mm_cmpgt_epi32(a, b);
+                return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b));
+            }
+
+            inline size_t find32Sse2(const int *a, size_t n, int value)
+            {
+                __m128i key=_mm_set1_epi32(value);
+                size_t i=0;
+                for(;i+4<=n;i+=4)
+                {
+                    unsigned int m=_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(a+i)), key));
+                    if(m) return i+lowBit(m)/4;
+                }
+                for(;i<n&&a[i]!=value;++i);
+                return i;
+            }
+
+            SJTU_AVX2 inline size_t find32Avx2(const int *a, size_t n, int value)
+            {
+                __m256i key=_mm256_set1_epi32(value);
+                size_t i=0;
+                for(;i+8<=n;i+=8)
+                {
+                    unsigned int m=_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(a+i)), key));
+                    if(m) return i+lowBit(m)/4;
+                }
+                for(;i<n&&a[i]!=value;++i);
+                return i;
+            }
+
+            inline size_t count32Sse2(const int *a, size_t n, int value)
+            {
+                __m128i key=_mm_set1_epi32(value), acc=_mm_setzero_si128();
+                size_t i=0, c=0;
+                for(;i+4<=n;i+=4)
+                    acc=_mm_sub_epi32(acc, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(a+i)), key));
+                unsigned int lanes[4];
+                _mm_storeu_si128((__m128i *)lanes, acc);
+                for(int k=0;k<4;++k)
+                    c+=lanes[k];
+                for(;i<n;++i)
+                    c+=a[i]==value;
+                return c;
+            }
+
+            SJTU_AVX2 inline size_t count32Avx2(const int *a, size_t n, int value)
+            {
+                __m256i key=_mm256_set1_epi32(value), acc=_mm256_setzero_si256();
+                size_t i=0, c=0;
+                for(;i+8<=n;i+=8)
+                    acc=_mm256_sub_epi32(acc, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(a+i)), key));
+                unsigned int lanes[8];
+                _mm256_storeu_si256((__m256i *)lanes, acc);
+                for(int k=0;k<8;++k)
+                    c+=lanes[k];
+                for(;i<n;++i)
+                    c+=a[i]==value;
+                return c;
+            }
+
+            inline int sum32Sse2(const int *a, size_t n)
+            {
+                __m128i acc=_mm_setzero_si128();
+                size_t i=0;
+                for(;i+4<=n;i+=4)
+                    acc=_mm_add_epi32(acc, _mm_loadu_si128((const __m128i *)(a+i)));
+                unsigned int lanes[4], s=0;
+                _mm_storeu_si128((__m128i *)lanes, acc);
+                for(int k=0;k<4;++k)
+                    s+=lanes[k];
+                for(;i<n;++i)
+                    s+=(unsigned int)a[i];
+                return (int)s;
+            }
+
+            SJTU_AVX2 inline int sum32Avx2(const int *a, size_t n)
+            {
+                __m256i acc=_mm256_setzero_si256();
+                size_t i=0;
+                for(;i+8<=n;i+=8)
+                    acc=_mm256_add_epi32(acc, _mm256_loadu_si256((const __m256i *)(a+i)));
+                unsigned int lanes[8], s=0;
+                _mm256_storeu_si256((__m256i *)lanes, acc);
+                for(int k=0;k<8;++k)
+                    s+=lanes[k];
+                for(;i<n;++i)
+                    s+=(unsigned int)a[i];
+                return (int)s;
+            }
+
+            /**
+             * the smallest (wantMax false) or largest element of a non-empty range.
+             */
+            inline int extreme32Sse2(const int *a, size_t n, bool wantMax)
+            {
+                int best=a[0];
+                size_t i=0;
+                if(n>=4)
+                {
+                    __m128i acc=_mm_loadu_si128((const __m128i *)a);
+                    for(i=4;i+4<=n;i+=4)
+                    {
+                        __m128i v=_mm_loadu_si128((const __m128i *)(a+i));
+                        acc=wantMax?max32(acc, v):min32(acc, v);
+                    }
+                    int lanes[4];
+                    _mm_storeu_si128((__m128i *)lanes, acc);
+                    for(int k=0;k<4;++k)
+                        if(wantMax?lanes[k]>best:lanes[k]<best) best=lanes[k];
+                }
+                for(;i<n;++i)
+                    if(wantMax?a[i]>best:a[i]<best) best=a[i];
+                return best;
+            }
+
+            SJTU_AVX2 inline int extreme32Avx2(const int *a, size_t n, bool wantMax)
+            {
+                int best=a[0];
+                size_t i=0;
+                if(n>=8)
+                {
+                    __m256i acc=_mm256_loadu_si256((const __m256i *)a);
+                    for(i=8;i+8<=n;i+=8)
+                    {
+                        __m256i v=_mm256_loadu_si256((const __m256i *)(a+i));
+                        acc=wantMax?_mm256_max_epi32(acc, v):_mm256_min_epi32(acc, v);
+                    }
+                    int lanes[8];
+                    _mm256_storeu_si256((__m256i *)lanes, acc);
+                    for(int k=0;k<8;++k)
+                        if(wantMax?lanes[k]>best:lanes[k]<best) best=lanes[k];
+                }
+                for(;i<n;++i)
+                    if(wantMax?a[i]>best:a[i]<best) best=a[i];
+                return best;
+            }
+
+            // long long: 2 lanes in SSE2, 4 lanes in AVX2
+
+            /**
+             * SSE2 has no 64-bit compare, so both 32-bit halves must match.
+             */
+            inline __m128i cmpeq64(__m128i a, __m128i b)
+            {
+                __m128i eq=_mm_cmpeq_epi32(a, b);
+                return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+
+            inline size_t find64Sse2(const long long *a, size_t n, long long value)
+            {
+                __m128i key=_mm_set1_epi64x(value);
+                size_t i=0;
+                for(;i+2<=n;i+=2)
+                {
+                    unsigned int m=_mm_movemask_epi8(cmpeq64(_mm_loadu_si128((const __m128i *)(a+i)), key));
+                    if(m) return i+lowBit(m)/8;
+                }
+                for(;i<n&&a[i]!=value;++i);
+                return i;
+            }
+
+            SJTU_AVX2 inline size_t find64Avx2(const long long *a, size_t n, long long value)
+            {
+                __m256i key=_mm256_set1_epi64x(value);
+                size_t i=0;
+                for(;i+4<=n;i+=4)
+                {
+                    unsigned int m=_mm256_movemask_epi8(_mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(a+i)), key));
+                    if(m) return i+lowBit(m)/8;
+                }
+                for(;i<n&&a[i]!=value;++i);
+                return i;
+            }
+
+            inline size_t count64Sse2(const long long *a, size_t n, long long value)
+            {
+                __m128i key=_mm_set1_epi64x(value), acc=_mm_setzero_si128();
+                size_t i=0, c=0;
+                for(;i+2<=n;i+=2)
+                    acc=_mm_sub_epi64(acc, cmpeq64(_mm_loadu_si128((const __m128i *)(a+i)), key));
+                unsigned long long lanes[2];
+                _mm_storeu_si128((__m128i *)lanes, acc);
+                c=lanes[0]+lanes[1];
+                for(;i<n;++i)
+                    c+=a[i]==value;
+                return c;
+            }
+
+            SJTU_AVX2 inline size_t count64Avx2(const long long *a, size_t n, long long value)
+            {
+                __m256i key=_mm256_set1_epi64x(value), acc=_mm256_setzero_si256();
+                size_t i=0, c=0;
+                for(;i+4<=n;i+=4)
+                    acc=_mm256_sub_epi64(acc, _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)(a+i)), key));
+                unsigned long long lanes[4];
+                _mm256_storeu_si256((__m256i *)lanes, acc);
+                for(int k=0;k<4;++k)
+                    c+=lanes[k];
+                for(;i<n;++i)
+                    c+=a[i]==value;
+                return c;
+            }
+
+            inline long long sum64Sse2(const long long *a, size_t n)
+            {
+                __m128i acc=_mm_setzero_si128();
+                size_t i=0;
+                for(;i+2<=n;i+=2)
+                    acc=_mm_add_epi64(acc, _mm_loadu_si128((const __m128i *)(a+i)));
+                unsigned long long lanes[2];
+                _mm_storeu_si128((__m128i *)lanes, acc);
+                unsigned long long s=lanes[0]+lanes[1];
+                for(;i<n;++i)
+                    s+=(unsigned long long)a[i];
+                return (long long)s;
+            }
+
+            SJTU_AVX2 inline long long sum64Avx2(const long long *a, size_t n)
+            {
+                __m256i acc=_mm256_setzero_si256();
+                size_t i=0;
+                for(;i+4<=n;i+=4)
+                    acc=_mm256_add_epi64(acc, _mm256_loadu_si256((const __m256i *)(a+i)));
+                unsigned long long lanes[4], s=0;
+                _mm256_storeu_si256((__m256i *)lanes, acc);
+                for(int k=0;k<4;++k)
+                    s+=lanes[k];
+                for(;i<n;++i)
+                    s+=(unsigned long long)a[i];
+                return (long long)s;
+            }
+
+            /**
+             * AVX2 has no 64-bit min/max, blend on a greater-than mask instead.
+             * SSE2 lacks the 64-bit compare as well and uses the plain loop.
+             */
+            SJTU_AVX2 inline long long extreme64Avx2(const long long *a, size_t n, bool wantMax)
+            {
+                long long best=a[0];
+                size_t i=0;
+                if(n>=4)
+                {
+                    __m256i acc=_mm256_loadu_si256((const __m256i *)a);
+                    for(i=4;i+4<=n;i+=4)
+                    {
+                        __m256i v=_mm256_loadu_si256((const __m256i *)(a+i));
+                        __m256i gt=_mm256_cmpgt_epi64(acc, v);
+                        acc=wantMax?_mm256_blendv_epi8(v, acc, gt):_mm256_blendv_epi8(acc, v, gt);
+                    }
+                    long long lanes[4];
+                    _mm256_storeu_si256((__m256i *)lanes, acc);
+                    for(int k=0;k<4;++k)
+                        if(wantMax?lanes[k]>best:lanes[k]<best) best=lanes[k];
+                }
+                for(;i<n;++i)
+                    if(wantMax?a[i]>best:a[i]<best) best=a[i];
+                return best;
+            }
+
+            // double: 2 lanes in SSE2, 4 lanes in AVX2
+
+            inline size_t findDoubleSse2(const double *a, size_t n, double value)
+            {
+                __m128d key=_mm_set1_pd(value);
+                size_t i=0;
+                for(;i+2<=n;i+=2)
+                {
+                    unsigned int m=_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(a+i), key));
+                    if(m) return i+lowBit(m);
+                }
+                for(;i<n&&a[i]!=value;++i);
+                return i;
+            }
+
+            SJTU_AVX2 inline size_t findDoubleAvx2(const double *a, size_t n, double value)
+            {
+                __m256d key=_mm256_set1_pd(value);
+                size_t i=0;
+                for(;i+4<=n;i+=4)
+                {
+                    unsigned int m=_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a+i), key, _CMP_EQ_OQ));
+                    if(m) return i+lowBit(m);
+                }
+                for(;i<n&&a[i]!=value;++i);
+                return i;
+            }
+
+            inline size_t countDoubleSse2(const double *a, size_t n, double value)
+            {
+                __m128d key=_mm_set1_pd(value);
+                __m128i acc=_mm_setzero_si128();
+                size_t i=0, c=0;
+                for(;i+2<=n;i+=2)
+                    acc=_mm_sub_epi64(acc, _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(a+i), key)));
+                unsigned long long lanes[2];
+                _mm_storeu_si128((__m128i *)lanes, acc);
+                c=lanes[0]+lanes[1];
+                for(;i<n;++i)
+                    c+=a[i]==value;
+                return c;
+            }
+
+            SJTU_AVX2 inline size_t countDoubleAvx2(const double *a, size_t n, double value)
+            {
+                __m256d key=_mm256_set1_pd(value);
+                __m256i acc=_mm256_setzero_si256();
+                size_t i=0, c=0;
+                for(;i+4<=n;i+=4)
+                    acc=_mm256_sub_epi64(acc, _mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(a+i), key, _CMP_EQ_OQ)));
+                unsigned long long lanes[4];
+                _mm256_storeu_si256((__m256i *)lanes, acc);
+                for(int k=0;k<4;++k)
+                    c+=lanes[k];
+                for(;i<n;++i)
+                    c+=a[i]==value;
+                return c;
+            }
+
+            inline double sumDoubleSse2(const double *a, size_t n)
+            {
+                __m128d acc0=_mm_setzero_pd(), acc1=_mm_setzero_pd();
+                size_t i=0;
+                for(;i+4<=n;i+=4)
+                {
+                    acc0=_mm_add_pd(acc0, _mm_loadu_pd(a+i));
+                    acc1=_mm_add_pd(acc1, _mm_loadu_pd(a+i+2));
+                }
+                double lanes[2];
+                _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+                double s=lanes[0]+lanes[1];
+                for(;i<n;++i)
+                    s+=a[i];
+                return s;
+            }
+
+            SJTU_AVX2 inline double sumDoubleAvx2(const double *a, size_t n)
+            {
+                __m256d acc0=_mm256_setzero_pd(), acc1=_mm256_setzero_pd();
+                size_t i=0;
+                for(;i+8<=n;i+=8)
+                {
+                    acc0=_mm256_add_pd(acc0, _mm256_loadu_pd(a+i));
+                    acc1=_mm256_add_pd(acc1, _mm256_loadu_pd(a+i+4));
+                }
+                double lanes[4], s=0;
+                _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+                for(int k=0;k<4;++k)
+                    s+=lanes[k];
+                for(;i<n;++i)
+                    s+=a[i];
+                return s;
+            }
+
+            inline double extremeDoubleSse2(const double *a, size_t n, bool wantMax)
+            {
+                double best=a[0];
+                size_t i=0;
+                if(n>=2)
+                {
+                    __m128d acc=_mm_loadu_pd(a);
+                    for(i=2;i+2<=n;i+=2)
+                    {
+                        __m128d v=_mm_loadu_pd(a+i);
+                        acc=wantMax?_mm_max_pd(acc, v):_mm_min_pd(acc, v);
+                    }
+                    double lanes[2];
+                    _mm_storeu_pd(lanes, acc);
+                    for(int k=0;k<2;++k)
+                        if(wantMax?lanes[k]>best:lanes[k]<best) best=lanes[k];
+                }
+                for(;i<n;++i)
+                    if(wantMax?a[i]>best:a[i]<best) best=a[i];
+                return best;
+            }
+
+            SJTU_AVX2 inline double extremeDoubleAvx2(const double *a, size_t n, bool wantMax)
+            {
+                double best=a[0];
+                size_t i=0;
+                if(n>=4)
+                {
+                    __m256d acc=_mm256_loadu_pd(a);
+                    for(i=4;i+4<=n;i+=4)
+                    {
+                        __m256d v=_mm256_loadu_pd(a+i);
+                        acc=wantMax?_mm256_max_pd(acc, v):_mm256_min_pd(acc, v);
+                    }
+                    double lanes[4];
+                    _mm256_storeu_pd(lanes, acc);
+                    for(int k=0;k<4;++k)
+                        if(wantMax?lanes[k]>best:lanes[k]<best) best=lanes[k];
+                }
+                for(;i<n;++i)
+                    if(wantMax?a[i]>best:a[i]<best) best=a[i];
+                return best;
+            }
+
+#undef SJTU_AVX2
+        }
+
+/**
+ * the specializations dispatch on active(); min/max find the extreme value
+ * with the vector kernel and then its first position with the find kernel.
+ */
+#define SJTU_SIMD_KERNELS(T, SUFFIX, EXTREME_SSE2)                                          \
+        template<>                                                                          \
+        struct kernels<T>                                                                   \
+        {                                                                                   \
+            static const T *find(const T *first, const T *last, T value)                    \
+            {                                                                               \
+                size_t n=last-first;                                                        \
+                switch(active())                                                            \
+                {                                                                           \
+                    case AVX2: return first+detail::find##SUFFIX##Avx2(first, n, value);    \
+                    case SSE2: return first+detail::find##SUFFIX##Sse2(first, n, value);    \
+                    default: return scalar<T>::find(first, last, value);                    \
+                }                                                                           \
+            }                                                                               \
+                                                                                            \
+            static size_t count(const T *first, const T *last, T value)                     \
+            {                                                                               \
+                size_t n=last-first;                                                        \
+                switch(active())                                                            \
+                {                                                                           \
+                    case AVX2: return detail::count##SUFFIX##Avx2(first, n, value);         \
+                    case SSE2: return detail::count##SUFFIX##Sse2(first, n, value);         \
+                    default: return scalar<T>::count(first, last, value);                   \
+                }                                                                           \
+            }                                                                               \
+                                                                                            \
+            static T sum(const T *first, const T *last)                                     \
+            {                                                                               \
+                size_t n=last-first;                                                        \
+                switch(active())                                                            \
+                {                                                                           \
+                    case AVX2: return detail::sum##SUFFIX##Avx2(first, n);                  \
+                    case SSE2: return detail::sum##SUFFIX##Sse2(first, n);                  \
+                    default: return scalar<T>::sum(first, last);                            \
+                }                                                                           \
+            }                                                                               \
+                                                                                            \
+            static const T *extreme(const T *first, const T *last, bool wantMax)            \
+            {                                                                               \
+                if(first==last) return last;                                                \
+                size_t n=last-first;                                                        \
+                T best;                                                                     \
+                switch(active())                                                            \
+                {                                                                           \
+                    case AVX2: best=detail::extreme##SUFFIX##Avx2(first, n, wantMax); break;\
+                    case SSE2: EXTREME_SSE2; break;                                         \
+                    default:                                                                \
+                        return wantMax?scalar<T>::max_element(first, last)                  \
+                                      :scalar<T>::min_element(first, last);                 \
+                }                                                                           \
+                return find(first, last, best);                                             \
+            }                                                                               \
+                                                                                            \
+            static const T *min_element(const T *first, const T *last)                      \
+            {                                                                               \
+                return extreme(first, last, false);                                         \
+            }                                                                               \
+                                                                                            \
+            static const T *max_element(const T *first, const T *last)                      \
+            {                                                                               \
+                return extreme(first, last, true);                                          \
+            }                                                                               \
+        };
+
+        SJTU_SIMD_KERNELS(int, 32, best=detail::extreme32Sse2(first, n, wantMax))
+        SJTU_SIMD_KERNELS(long long, 64,
+                          return wantMax?scalar<long long>::max_element(first, last)
+                                        :scalar<long long>::min_element(first, last))
+        SJTU_SIMD_KERNELS(double, Double, best=detail::extremeDoubleSse2(first, n, wantMax))
+
+#undef SJTU_SIMD_KERNELS
+#endif
+    }
+
+/**
+ * the first element equal to value, or end().
+ */
+    template<typename T, typename Growth, typename Alloc, typename Size>
+    typename vector<T, Growth, Alloc, Size>::const_iterator find(const vector<T, Growth, Alloc, Size> &v, const T &value)
+    {
+        const T *first=v.data();
+        return v.cbegin()+(simd::kernels<T>::find(first, first+v.size(), value)-first);
+    }
+
+/**
+ * the number of elements equal to value.
+ */
+    template<typename T, typename Growth, typename Alloc, typename Size>
+    size_t count(const vector<T, Growth, Alloc, Size> &v, const T &value)
+    {
+        return simd::kernels<T>::count(v.data(), v.data()+v.size(), value);
+    }
+
+/**
+ * the sum of all elements, T() when empty.
+ */
+    template<typename T, typename Growth, typename Alloc, typename Size>
+    T sum(const vector<T, Growth, Alloc, Size> &v)
+    {
+        return simd::kernels<T>::sum(v.data(), v.data()+v.size());
+    }
+
+/**
+ * the first smallest element, or end() when empty.
+ */
+    template<typename T, typename Growth, typename Alloc, typename Size>
+    typename vector<T, Growth, Alloc, Size>::const_iterator min_element(const vector<T, Growth, Alloc, Size> &v)
+    {
+        const T *first=v.data();
+        return v.cbegin()+(simd::kernels<T>::min_element(first, first+v.size())-first);
+    }
+
+/**
+ * the first largest element, or end() when empty.
+ */
+    template<typename T, typename Growth, typename Alloc, typename Size>
+    typename vector<T, Growth, Alloc, Size>::const_iterator max_element(const vector<T, Growth, Alloc, Size> &v)
+    {
+        const T *first=v.data();
+        return v.cbegin()+(simd::kernels<T>::max_element(first, first+v.size())-first);
+    }
+}
+
+#endif
@@ -0,0 +1,717 @@
+#ifndef SJTU_SMALL_VECTOR_HPP
+#define SJTU_SMALL_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu
+{
+/**
+ * a data container like sjtu::vector which keeps up to N elements
+ * inside the object itself, and only moves them to the heap once it
+ * grows past N. short lists then cost no allocation at all.
+ */
+    template<typename T, size_t N=16>
+    class small_vector
+    {
+        static_assert(N>0, "small_vector needs room for at least one inline element");
+
+    private:
+        T *_data;
+        size_t _size;
+        size_t _capacity;
+        alignas(T) unsigned char buffer[N*sizeof(T)];
+
+        typedef std::integral_constant<bool, is_trivially_relocatable<T>::value> trivially_relocatable;
+
+        T *inlineData()
+        {
+            return reinterpret_cast<T *>(buffer);
+        }
+
+        static T *allocate(size_t n)
+        {
+            return static_cast<T *>(::operator new(n*sizeof(T)));
+        }
+
+        static void destroy(T *first, T *last)
+        {
+            for(;first!=last;++first)
+                first->~T();
+        }
+
+        static void relocate(T *first, T *last, T *dest)
+        {
+            relocate(first, last, dest, trivially_relocatable());
+        }
+
+        static void relocate(T *first, T *last, T *dest, std::true_type)
+        {
+            if(first!=last) std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), (last-first)*sizeof(T));
+        }
+
+        /**
+         * the sources are destroyed only once every element has been built
+         * at dest, so a throw leaves them as they were.
+         */
+        static void relocate(T *first, T *last, T *dest, std::false_type)
+        {
+            moveConstruct(first, last, dest);
+            destroy(first, last);
+        }
+
+        /**
+         * move [first, last) into the raw storage at dest, copying when T's
+         * move constructor may throw; if one throws, the ones built are
+         * destroyed again.
+         */
+        static void moveConstruct(T *first, T *last, T *dest)
+        {
+            T *cur=dest;
+            try
+            {
+                for(;first!=last;++first,++cur)
+                    new(cur) T(std::move_if_noexcept(*first));
+            } catch(...)
+            {
+                destroy(dest, cur);
+                throw;
+            }
+        }
+
+        /**
+         * relocate the elements into temp, leaving slot pos of it free.
+         */
+        void relocateAround(T *temp, size_t pos)
+        {
+            relocateAround(temp, pos, trivially_relocatable());
+        }
+
+        void relocateAround(T *temp, size_t pos, std::true_type)
+        {
+            relocate(_data, _data+pos, temp, std::true_type());
+            relocate(_data+pos, _data+_size, temp+pos+1, std::true_type());
+        }
+
+        void relocateAround(T *temp, size_t pos, std::false_type)
+        {
+            moveConstruct(_data, _data+pos, temp);
+            try
+            {
+                moveConstruct(_data+pos, _data+_size, temp+pos+1);
+            } catch(...)
+            {
+                destroy(temp, temp+pos);
+                throw;
+            }
+            destroy(_data, _data+_size);
+        }
+
+        /**
+         * give the heap buffer back, if any, and point at the inline one.
+         * the elements must have been destroyed or relocated already.
+         */
+        void releaseHeap()
+        {
+            if(!is_inline()) ::operator delete(_data);
+            _data=inlineData();
+            _capacity=N;
+        }
+
+        /**
+         * move the elements to a buffer of newCapacity (>= size),
+         * which is the inline one when newCapacity <= N.
+         */
+        void reallocate(size_t newCapacity)
+        {
+            T *temp=newCapacity>N?allocate(newCapacity):inlineData();
+            if(temp==_data) return;
+            try
+            {
+                relocate(_data, _data+_size, temp);
+            } catch(...)
+            {
+                if(temp!=inlineData()) ::operator delete(temp);
+                throw;
+            }
+            if(!is_inline()) ::operator delete(_data);
+            _data=temp;
+            _capacity=newCapacity>N?newCapacity:N;
+        }
+
+        /**
+         * take over the elements of other, leaving it empty and inline.
+         */
+        void steal(small_vector &other)
+        {
+            if(other.is_inline())
+            {
+                relocate(other._data, other._data+other._size, inlineData());
+                _data=inlineData();
+                _capacity=N;
+            } else
+            {
+                _data=other._data;
+                _capacity=other._capacity;
+                other._data=other.inlineData();
+                other._capacity=N;
+            }
+            _size=other._size;
+            other._size=0;
+        }
+
+        template<typename... Args>
+        void emplaceAt(size_t pos, Args &&...args)
+        {
+            if(_size==_capacity)
+            {
+                size_t newCapacity=_capacity*2;
+                T *temp=allocate(newCapacity);
+                try
+                {
+                    new(temp+pos) T(std::forward<Args>(args)...);
+                } catch(...)
+                {
+                    ::operator delete(temp);
+                    throw;
+                }
+                try
+                {
+                    relocateAround(temp, pos);
+                } catch(...)
+                {
+                    temp[pos].~T();
+                    ::operator delete(temp);
+                    throw;
+                }
+                if(!is_inline()) ::operator delete(_data);
+                _data=temp;
+                _capacity=newCapacity;
+                _size++;
+                return;
+            }
+            if(pos==_size)
+            {
+                new(_data+_size) T(std::forward<Args>(args)...);
+                _size++;
+                return;
+            }
+            T value(std::forward<Args>(args)...);
+            //shift [pos, size) one slot right by construction, so T needs no
+            //assignment operator; if a move throws, what already moved is dropped
+            size_t i=_size;
+            try
+            {
+                for(;i>pos;--i)
+                {
+                    new(_data+i) T(std::move(_data[i-1]));
+                    _data[i-1].~T();
+                }
+                new(_data+pos) T(std::move(value));
+            } catch(...)
+            {
+                destroy(_data+i+1, _data+_size+1);
+                _size=i;
+                throw;
+            }
+            _size++;
+        }
+
+        void eraseAt(size_t pos)
+        {
+            _data[pos].~T();
+            size_t i=pos+1;
+            try
+            {
+                for(;i<_size;++i)
+                {
+                    new(_data+i-1) T(std::move(_data[i]));
+                    _data[i].~T();
+                }
+            } catch(...)
+            {
+                destroy(_data+i, _data+_size);
+                _size=i-1;
+                throw;
+            }
+            _size--;
+        }
+
+    public:
+        class const_iterator;
+
+        class iterator
+        {
+            friend class small_vector;
+
+        private:
+            small_vector *vec;
+            size_t ptr;
+
+        public:
+            iterator operator+(const int &n) const
+            {
+                iterator it=*this;
+                it.ptr+=n;
+                return it;
+            }
+
+            iterator operator-(const int &n) const
+            {
+                iterator it=*this;
+                it.ptr-=n;
+                return it;
+            }
+
+            // return the distance between two iterators,
+            // if these two iterators point to different vectors, throw invaild_iterator.
+            int operator-(const iterator &rhs) const
+            {
+                if(vec!=rhs.vec) throw invalid_iterator();
+                return ptr-rhs.ptr;
+            }
+
+            iterator &operator+=(const int &n)
+            {
+                ptr+=n;
+                return *this;
+            }
+
+            iterator &operator-=(const int &n)
+            {
+                ptr-=n;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator it=*this;
+                ptr++;
+                return it;
+            }
+
+            iterator &operator++()
+            {
+                ptr++;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                iterator it=*this;
+                ptr--;
+                return it;
+            }
+
+            iterator &operator--()
+            {
+                ptr--;
+                return *this;
+            }
+
+            T &operator*() const
+            {
+                return vec->_data[ptr];
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+        };
+
+        class const_iterator
+        {
+            friend class small_vector;
+
+        private:
+            const small_vector *vec;
+            size_t ptr;
+
+        public:
+            const_iterator operator+(const int &n) const
+            {
+                const_iterator it=*this;
+                it.ptr+=n;
+                return it;
+            }
+
+            const_iterator operator-(const int &n) const
+            {
+                const_iterator it=*this;
+                it.ptr-=n;
+                return it;
+            }
+
+            int operator-(const const_iterator &rhs) const
+            {
+                if(vec!=rhs.vec) throw invalid_iterator();
+                return ptr-rhs.ptr;
+            }
+
+            const_iterator &operator+=(const int &n)
+            {
+                ptr+=n;
+                return *this;
+            }
+
+            const_iterator &operator-=(const int &n)
+            {
+                ptr-=n;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator it=*this;
+                ptr++;
+                return it;
+            }
+
+            const_iterator &operator++()
+            {
+                ptr++;
+                return *this;
+            }
+
+            const_iterator operator--(int)
+            {
+                const_iterator it=*this;
+                ptr--;
+                return it;
+            }
+
+            const_iterator &operator--()
+            {
+                ptr--;
+                return *this;
+            }
+
+            const T &operator*() const
+            {
+                return vec->_data[ptr];
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+        };
+
+        small_vector()
+        {
+            _data=inlineData();
+            _size=0;
+            _capacity=N;
+        }
+
+        small_vector(const small_vector &other)
+        {
+            _data=other._size>N?allocate(other._size):inlineData();
+            _capacity=other._size>N?other._size:N;
+            try
+            {
+                for(_size=0;_size<other._size;++_size)
+                    new(_data+_size) T(other._data[_size]);
+            } catch(...)
+            {
+                destroy(_data, _data+_size);
+                if(!is_inline()) ::operator delete(_data);
+                throw;
+            }
+        }
+
+        small_vector(small_vector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            steal(other);
+        }
+
+        ~small_vector()
+        {
+            destroy(_data, _data+_size);
+            releaseHeap();
+        }
+
+        small_vector &operator=(const small_vector &other)
+        {
+            if(this==&other) return *this;
+
+            clear();
+            if(other._size>_capacity)
+            {
+                releaseHeap();
+                _data=allocate(other._size);
+                _capacity=other._size;
+            }
+            for(;_size<other._size;++_size)
+                new(_data+_size) T(other._data[_size]);
+            return *this;
+        }
+
+        small_vector &operator=(small_vector &&other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        {
+            if(this==&other) return *this;
+
+            clear();
+            releaseHeap();
+            steal(other);
+            return *this;
+        }
+
+        /**
+         * access specified element with bounds checking
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        T &at(const size_t &pos)
+        {
+            if(pos>=_size) throw index_out_of_bound();
+            return _data[pos];
+        }
+
+        const T &at(const size_t &pos) const
+        {
+            if(pos>=_size) throw index_out_of_bound();
+            return _data[pos];
+        }
+
+        T &operator[](const size_t &pos)
+        {
+            if(pos>=_size) throw index_out_of_bound();
+            return _data[pos];
+        }
+
+        const T &operator[](const size_t &pos) const
+        {
+            if(pos>=_size) throw index_out_of_bound();
+            return _data[pos];
+        }
+
+        /**
+         * access the first element.
+         * throw container_is_empty if size == 0
+         */
+        const T &front() const
+        {
+            if(_size==0) throw container_is_empty();
+            return _data[0];
+        }
+
+        /**
+         * access the last element.
+         * throw container_is_empty if size == 0
+         */
+        const T &back() const
+        {
+            if(_size==0) throw container_is_empty();
+            return _data[_size-1];
+        }
+
+        T *data()
+        {
+            return _data;
+        }
+
+        const T *data() const
+        {
+            return _data;
+        }
+
+        iterator begin()
+        {
+            iterator it;
+            it.vec=this;
+            it.ptr=0;
+            return it;
+        }
+
+        const_iterator cbegin() const
+        {
+            const_iterator it;
+            it.vec=this;
+            it.ptr=0;
+            return it;
+        }
+
+        iterator end()
+        {
+            iterator it;
+            it.vec=this;
+            it.ptr=_size;
+            return it;
+        }
+
+        const_iterator cend() const
+        {
+            const_iterator it;
+            it.vec=this;
+            it.ptr=_size;
+            return it;
+        }
+
+        bool empty() const
+        {
+            return _size==0;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        size_t capacity() const
+        {
+            return _capacity;
+        }
+
+        /**
+         * whether the elements currently live in the inline buffer.
+         */
+        bool is_inline() const
+        {
+            return _data==reinterpret_cast<const T *>(buffer);
+        }
+
+        /**
+         * clears the contents, keeping the current buffer.
+         */
+        void clear()
+        {
+            destroy(_data, _data+_size);
+            _size=0;
+        }
+
+        void reserve(size_t n)
+        {
+            if(n>_capacity) reallocate(n);
+        }
+
+        /**
+         * releases unused heap capacity, moving back inline when the elements fit.
+         */
+        void shrink_to_fit()
+        {
+            if(!is_inline()&&_size<_capacity) reallocate(_size);
+        }
+
+        /**
+         * inserts value before pos
+         * returns an iterator pointing to the inserted value.
+         */
+        iterator insert(iterator pos, const T &value)
+        {
+            emplaceAt(pos.ptr, value);
+            return pos;
+        }
+
+        iterator insert(iterator pos, T &&value)
+        {
+            emplaceAt(pos.ptr, std::move(value));
+            return pos;
+        }
+
+        /**
+         * inserts value at index ind.
+         * throw index_out_of_bound if ind > size
+         */
+        iterator insert(const size_t &ind, const T &value)
+        {
+            if(ind>_size) throw index_out_of_bound();
+            emplaceAt(ind, value);
+            return begin()+ind;
+        }
+
+        template<typename... Args>
+        iterator emplace(iterator pos, Args &&...args)
+        {
+            emplaceAt(pos.ptr, std::forward<Args>(args)...);
+            return pos;
+        }
+
+        /**
+         * removes the element at pos.
+         * return an iterator pointing to the following element.
+         */
+        iterator erase(iterator pos)
+        {
+            eraseAt(pos.ptr);
+            return pos;
+        }
+
+        /**
+         * removes the element with index ind.
+         * throw index_out_of_bound if ind >= size
+         */
+        iterator erase(const size_t &ind)
+        {
+            if(ind>=_size) throw index_out_of_bound();
+            eraseAt(ind);
+            return begin()+ind;
+        }
+
+        void push_back(const T &value)
+        {
+            emplaceAt(_size, value);
+        }
+
+        void push_back(T &&value)
+        {
+            emplaceAt(_size, std::move(value));
+        }
+
+        template<typename... Args>
+        T &emplace_back(Args &&...args)
+        {
+            emplaceAt(_size, std::forward<Args>(args)...);
+            return _data[_size-1];
+        }
+
+        /**
+         * remove the last element from the end.
+         * throw container_is_empty if size() == 0
+         */
+        void pop_back()
+        {
+            if(_size==0) throw container_is_empty();
+            _size--;
+            _data[_size].~T();
+        }
+    };
+}
+
+#endif
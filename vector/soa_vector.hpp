@@ -0,0 +1,777 @@
+#ifndef SJTU_SOA_VECTOR_HPP
+#define SJTU_SOA_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu
+{
+/**
+ * a vector of records stored as a structure of arrays: field I of every
+ * row lives in its own contiguous column, column<I>(). a scan over one
+ * field reads only that field's bytes and is a plain loop over a T*, so
+ * the compiler can vectorize it.
+ *
+ * rows are added and read as std::tuple<Fields...> (value_type), or
+ * through reference / const_reference, proxies for one row whose get<I>()
+ * is the field itself. iterators are random access over rows.
+ *
+ * all columns share one size and capacity and grow together.
+ */
+    template<typename... Fields>
+    class soa_vector
+    {
+        static_assert(sizeof...(Fields)>0, "soa_vector needs at least one field");
+
+    public:
+        typedef std::tuple<Fields...> value_type;
+
+        template<size_t I>
+        using field_type=typename std::tuple_element<I, value_type>::type;
+
+    private:
+        static const size_t FIELDS=sizeof...(Fields);
+
+        template<size_t I>
+        using index=std::integral_constant<size_t, I>;
+
+        std::tuple<Fields *...> columns;
+        size_t _size;
+        size_t _capacity;
+
+        /**
+         * calls op(column, index<I>()) for every column in order.
+         */
+        template<typename Op, size_t I>
+        static void forEach(std::tuple<Fields *...> &cols, Op &op, index<I>)
+        {
+            op(std::get<I>(cols), index<I>());
+            forEach(cols, op, index<I+1>());
+        }
+
+        template<typename Op>
+        static void forEach(std::tuple<Fields *...> &, Op &, index<FIELDS>)
+        {}
+
+        template<typename Op>
+        void forEachColumn(Op op)
+        {
+            forEach(columns, op, index<0>());
+        }
+
+        template<typename T>
+        static void relocate(T *first, T *last, T *dest)
+        {
+            relocate(first, last, dest, std::integral_constant<bool, is_trivially_relocatable<T>::value>());
+        }
+
+        template<typename T>
+        static void relocate(T *first, T *last, T *dest, std::true_type)
+        {
+            if(first!=last) std::memmove(static_cast<void *>(dest), static_cast<const void *>(first), (last-first)*sizeof(T));
+        }
+
+        /**
+         * element-wise; walks backwards when dest is above first, so a
+         * shift inside one column is safe.
+         */
+        template<typename T>
+        static void relocate(T *first, T *last, T *dest, std::false_type)
+        {
+            if(dest>first)
+            {
+                for(T *src=last, *to=dest+(last-first);src!=first;)
+                {
+                    --src;
+                    --to;
+                    new(to) T(std::move_if_noexcept(*src));
+                    src->~T();
+                }
+                return;
+            }
+            for(;first!=last;++first,++dest)
+            {
+                new(dest) T(std::move_if_noexcept(*first));
+                first->~T();
+            }
+        }
+
+        struct Allocate
+        {
+            std::tuple<Fields *...> *fresh;
+            size_t capacity;
+
+            template<typename T, size_t I>
+            void operator()(T *, index<I>)
+            {
+                std::get<I>(*fresh)=capacity?static_cast<T *>(::operator new(capacity*sizeof(T))):nullptr;
+            }
+        };
+
+        struct Release
+        {
+            template<typename T, size_t I>
+            void operator()(T *&col, index<I>)
+            {
+                ::operator delete(col);
+                col=nullptr;
+            }
+        };
+
+        struct MoveInto
+        {
+            std::tuple<Fields *...> *fresh;
+            size_t size;
+
+            template<typename T, size_t I>
+            void operator()(T *&col, index<I>)
+            {
+                relocate(col, col+size, std::get<I>(*fresh));
+                ::operator delete(col);
+                col=std::get<I>(*fresh);
+            }
+        };
+
+        struct Destroy
+        {
+            size_t first, last;
+
+            template<typename T, size_t I>
+            void operator()(T *col, index<I>)
+            {
+                for(size_t i=first;i<last;++i)
+                    col[i].~T();
+            }
+        };
+
+        /**
+         * moves rows [pos, size) up one and builds the row at pos from value.
+         */
+        struct InsertRow
+        {
+            value_type *value;
+            size_t pos, size;
+
+            template<typename T, size_t I>
+            void operator()(T *col, index<I>)
+            {
+                relocate(col+pos, col+size, col+pos+1);
+                new(col+pos) T(std::move(std::get<I>(*value)));
+            }
+        };
+
+        struct EraseRow
+        {
+            size_t pos, size;
+
+            template<typename T, size_t I>
+            void operator()(T *col, index<I>)
+            {
+                col[pos].~T();
+                relocate(col+pos+1, col+size, col+pos);
+            }
+        };
+
+        struct CopyRow
+        {
+            const soa_vector *from;
+            size_t row;
+
+            template<typename T, size_t I>
+            void operator()(T *col, index<I>)
+            {
+                new(col+row) T(std::get<I>(from->columns)[row]);
+            }
+        };
+
+        struct AssignRow
+        {
+            const value_type *value;
+            size_t row;
+
+            template<typename T, size_t I>
+            void operator()(T *col, index<I>)
+            {
+                col[row]=std::get<I>(*value);
+            }
+        };
+
+        template<size_t I>
+        void readRow(size_t row, value_type &out, index<I>) const
+        {
+            std::get<I>(out)=std::get<I>(columns)[row];
+            readRow(row, out, index<I+1>());
+        }
+
+        void readRow(size_t, value_type &, index<FIELDS>) const
+        {}
+
+        value_type row(size_t i) const
+        {
+            value_type out;
+            readRow(i, out, index<0>());
+            return out;
+        }
+
+        void reallocate(size_t newCapacity)
+        {
+            std::tuple<Fields *...> fresh;
+            Allocate allocate={&fresh, newCapacity};
+            try
+            {
+                forEach(fresh, allocate, index<0>());
+            } catch(...)
+            {
+                //columns not reached yet are still null
+                Release release;
+                forEach(fresh, release, index<0>());
+                throw;
+            }
+            MoveInto move={&fresh, _size};
+            forEachColumn(move);
+            _capacity=newCapacity;
+        }
+
+        void insertRow(size_t pos, value_type &value)
+        {
+            if(_size==_capacity) reallocate(_capacity?_capacity*2:10);
+            InsertRow insert={&value, pos, _size};
+            forEachColumn(insert);
+            _size++;
+        }
+
+        void eraseRow(size_t pos)
+        {
+            EraseRow erase={pos, _size};
+            forEachColumn(erase);
+            _size--;
+        }
+
+        void copyFrom(const soa_vector &other)
+        {
+            if(other._size>_capacity) reallocate(other._size);
+            for(;_size<other._size;++_size)
+            {
+                CopyRow copy={&other, _size};
+                forEachColumn(copy);
+            }
+        }
+
+        void stealFrom(soa_vector &other)
+        {
+            columns=other.columns;
+            _size=other._size;
+            _capacity=other._capacity;
+            other.columns=std::tuple<Fields *...>();
+            other._size=other._capacity=0;
+        }
+
+        void destroyAll()
+        {
+            Destroy destroy={0, _size};
+            forEachColumn(destroy);
+            _size=0;
+        }
+
+        void releaseAll()
+        {
+            destroyAll();
+            forEachColumn(Release());
+        }
+
+    public:
+        /**
+         * a proxy for one row; get<I>() is the field in its column.
+         */
+        class reference
+        {
+            friend class soa_vector;
+
+        private:
+            soa_vector *vec;
+            size_t row;
+
+            reference(soa_vector *vec, size_t row) : vec(vec), row(row)
+            {}
+
+        public:
+            template<size_t I>
+            field_type<I> &get() const
+            {
+                return std::get<I>(vec->columns)[row];
+            }
+
+            operator value_type() const
+            {
+                return vec->row(row);
+            }
+
+            reference &operator=(const value_type &value)
+            {
+                AssignRow assign={&value, row};
+                vec->forEachColumn(assign);
+                return *this;
+            }
+
+            reference &operator=(const reference &other)
+            {
+                return *this=value_type(other);
+            }
+        };
+
+        class const_reference
+        {
+            friend class soa_vector;
+
+        private:
+            const soa_vector *vec;
+            size_t row;
+
+            const_reference(const soa_vector *vec, size_t row) : vec(vec), row(row)
+            {}
+
+        public:
+            template<size_t I>
+            const field_type<I> &get() const
+            {
+                return std::get<I>(vec->columns)[row];
+            }
+
+            operator value_type() const
+            {
+                return vec->row(row);
+            }
+        };
+
+        class const_iterator;
+
+        class iterator
+        {
+            friend class soa_vector;
+
+        private:
+            soa_vector *vec;
+            size_t ptr;
+
+        public:
+            iterator operator+(const int &n) const
+            {
+                iterator it=*this;
+                it.ptr+=n;
+                return it;
+            }
+
+            iterator operator-(const int &n) const
+            {
+                iterator it=*this;
+                it.ptr-=n;
+                return it;
+            }
+
+            // return the distance between two iterators,
+            // if these two iterators point to different vectors, throw invaild_iterator.
+            int operator-(const iterator &rhs) const
+            {
+                if(vec!=rhs.vec) throw invalid_iterator();
+                return ptr-rhs.ptr;
+            }
+
+            iterator &operator+=(const int &n)
+            {
+                ptr+=n;
+                return *this;
+            }
+
+            iterator &operator-=(const int &n)
+            {
+                ptr-=n;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator it=*this;
+                ptr++;
+                return it;
+            }
+
+            iterator &operator++()
+            {
+                ptr++;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                iterator it=*this;
+                ptr--;
+                return it;
+            }
+
+            iterator &operator--()
+            {
+                ptr--;
+                return *this;
+            }
+
+            reference operator*() const
+            {
+                return reference(vec, ptr);
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+        };
+
+        class const_iterator
+        {
+            friend class soa_vector;
+
+        private:
+            const soa_vector *vec;
+            size_t ptr;
+
+        public:
+            const_iterator operator+(const int &n) const
+            {
+                const_iterator it=*this;
+                it.ptr+=n;
+                return it;
+            }
+
+            const_iterator operator-(const int &n) const
+            {
+                const_iterator it=*this;
+                it.ptr-=n;
+                return it;
+            }
+
+            int operator-(const const_iterator &rhs) const
+            {
+                if(vec!=rhs.vec) throw invalid_iterator();
+                return ptr-rhs.ptr;
+            }
+
+            const_iterator &operator+=(const int &n)
+            {
+                ptr+=n;
+                return *this;
+            }
+
+            const_iterator &operator-=(const int &n)
+            {
+                ptr-=n;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator it=*this;
+                ptr++;
+                return it;
+            }
+
+            const_iterator &operator++()
+            {
+                ptr++;
+                return *this;
+            }
+
+            const_iterator operator--(int)
+            {
+                const_iterator it=*this;
+                ptr--;
+                return it;
+            }
+
+            const_iterator &operator--()
+            {
+                ptr--;
+                return *this;
+            }
+
+            const_reference operator*() const
+            {
+                return const_reference(vec, ptr);
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+        };
+
+        /**
+         * nothing is allocated until the first row arrives.
+         */
+        soa_vector() : _size(0), _capacity(0)
+        {}
+
+        soa_vector(const soa_vector &other) : _size(0), _capacity(0)
+        {
+            try
+            {
+                copyFrom(other);
+            } catch(...)
+            {
+                releaseAll();
+                throw;
+            }
+        }
+
+        soa_vector(soa_vector &&other) noexcept
+        {
+            stealFrom(other);
+        }
+
+        ~soa_vector()
+        {
+            releaseAll();
+        }
+
+        soa_vector &operator=(const soa_vector &other)
+        {
+            if(this==&other) return *this;
+            destroyAll();
+            copyFrom(other);
+            return *this;
+        }
+
+        soa_vector &operator=(soa_vector &&other) noexcept
+        {
+            if(this==&other) return *this;
+            releaseAll();
+            stealFrom(other);
+            return *this;
+        }
+
+        /**
+         * access specified row with bounds checking
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        reference at(const size_t &pos)
+        {
+            if(pos>=_size) throw index_out_of_bound();
+            return reference(this, pos);
+        }
+
+        const_reference at(const size_t &pos) const
+        {
+            if(pos>=_size) throw index_out_of_bound();
+            return const_reference(this, pos);
+        }
+
+        reference operator[](const size_t &pos)
+        {
+            return at(pos);
+        }
+
+        const_reference operator[](const size_t &pos) const
+        {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        const_reference front() const
+        {
+            if(_size==0) throw container_is_empty();
+            return const_reference(this, 0);
+        }
+
+        const_reference back() const
+        {
+            if(_size==0) throw container_is_empty();
+            return const_reference(this, _size-1);
+        }
+
+        /**
+         * the contiguous column of field I, size() elements long.
+         */
+        template<size_t I>
+        field_type<I> *column()
+        {
+            return std::get<I>(columns);
+        }
+
+        template<size_t I>
+        const field_type<I> *column() const
+        {
+            return std::get<I>(columns);
+        }
+
+        iterator begin()
+        {
+            iterator it;
+            it.vec=this;
+            it.ptr=0;
+            return it;
+        }
+
+        const_iterator cbegin() const
+        {
+            const_iterator it;
+            it.vec=this;
+            it.ptr=0;
+            return it;
+        }
+
+        iterator end()
+        {
+            iterator it;
+            it.vec=this;
+            it.ptr=_size;
+            return it;
+        }
+
+        const_iterator cend() const
+        {
+            const_iterator it;
+            it.vec=this;
+            it.ptr=_size;
+            return it;
+        }
+
+        bool empty() const
+        {
+            return _size==0;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        size_t capacity() const
+        {
+            return _capacity;
+        }
+
+        /**
+         * clears the contents, keeping the columns for reuse.
+         */
+        void clear()
+        {
+            destroyAll();
+        }
+
+        void reserve(size_t n)
+        {
+            if(n>_capacity) reallocate(n);
+        }
+
+        void shrink_to_fit()
+        {
+            if(_size<_capacity) reallocate(_size);
+        }
+
+        /**
+         * inserts value before pos
+         * returns an iterator pointing to the inserted row.
+         */
+        iterator insert(iterator pos, const value_type &value)
+        {
+            value_type copy(value);
+            insertRow(pos.ptr, copy);
+            return pos;
+        }
+
+        /**
+         * throw index_out_of_bound if ind > size
+         */
+        iterator insert(const size_t &ind, const value_type &value)
+        {
+            if(ind>_size) throw index_out_of_bound();
+            value_type copy(value);
+            insertRow(ind, copy);
+            return begin()+ind;
+        }
+
+        /**
+         * removes the row at pos.
+         * return an iterator pointing to the following row.
+         */
+        iterator erase(iterator pos)
+        {
+            eraseRow(pos.ptr);
+            return pos;
+        }
+
+        /**
+         * throw index_out_of_bound if ind >= size
+         */
+        iterator erase(const size_t &ind)
+        {
+            if(ind>=_size) throw index_out_of_bound();
+            eraseRow(ind);
+            return begin()+ind;
+        }
+
+        void push_back(const value_type &value)
+        {
+            value_type copy(value);
+            insertRow(_size, copy);
+        }
+
+        /**
+         * adds a row from one value per field.
+         * the values are copied first, so they may refer into this vector.
+         */
+        void push_back(const Fields &...values)
+        {
+            value_type copy(values...);
+            insertRow(_size, copy);
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_back()
+        {
+            if(_size==0) throw container_is_empty();
+            eraseRow(_size-1);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,414 @@
+#ifndef SJTU_SORT_HPP
+#define SJTU_SORT_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu
+{
+    namespace detail
+    {
+        const size_t INSERTION_LIMIT=16;
+        const size_t RADIX_LIMIT=256;
+
+        template<typename It>
+        struct value_of
+        {
+            typedef typename std::decay<decltype(*std::declval<It>())>::type type;
+        };
+
+        template<typename T, typename Compare>
+        void insertionSort(T *a, size_t n, Compare comp)
+        {
+            for(size_t i=1;i<n;++i)
+            {
+                T value(std::move(a[i]));
+                size_t j=i;
+                for(;j>0&&comp(value, a[j-1]);--j)
+                    a[j]=std::move(a[j-1]);
+                a[j]=std::move(value);
+            }
+        }
+
+        /**
+         * stable merge of the sorted runs [a, a+mid) and [a+mid, a+n) through tmp.
+         */
+        template<typename T, typename Compare>
+        void merge(T *a, T *tmp, size_t mid, size_t n, Compare comp)
+        {
+            size_t i=0, j=mid, k=0;
+            while(i<mid&&j<n)
+            {
+                if(comp(a[j], a[i])) tmp[k++]=std::move(a[j++]);
+                else tmp[k++]=std::move(a[i++]);
+            }
+            while(i<mid)
+                tmp[k++]=std::move(a[i++]);
+            while(j<n)
+                tmp[k++]=std::move(a[j++]);
+            for(k=0;k<n;++k)
+                a[k]=std::move(tmp[k]);
+        }
+
+        template<typename T, typename Compare>
+        void siftDown(T *a, size_t i, size_t n, Compare &comp)
+        {
+            T value(std::move(a[i]));
+            for(size_t child;(child=2*i+1)<n;i=child)
+            {
+                if(child+1<n&&comp(a[child], a[child+1])) child++;
+                if(!comp(value, a[child])) break;
+                a[i]=std::move(a[child]);
+            }
+            a[i]=std::move(value);
+        }
+
+        template<typename T, typename Compare>
+        void heapSort(T *a, size_t n, Compare &comp)
+        {
+            using std::swap;
+            for(size_t i=n/2;i-->0;)
+                siftDown(a, i, n, comp);
+            for(size_t i=n-1;i>0;--i)
+            {
+                swap(a[0], a[i]);
+                siftDown(a, 0, i, comp);
+            }
+        }
+
+        /**
+         * swaps the median of *x, *y and *z into *result.
+         */
+        template<typename T, typename Compare>
+        void medianToFront(T *result, T *x, T *y, T *z, Compare &comp)
+        {
+            using std::swap;
+            if(comp(*x, *y))
+            {
+                if(comp(*y, *z)) swap(*result, *y);
+                else if(comp(*x, *z)) swap(*result, *z);
+                else swap(*result, *x);
+            } else if(comp(*x, *z)) swap(*result, *x);
+            else if(comp(*y, *z)) swap(*result, *z);
+            else swap(*result, *y);
+        }
+
+        /**
+         * hoare partition of [first, last) around *pivot, which lies just
+         * before first. the median of three leaves an element on each side
+         * that stops the scans, so they need no bounds checks.
+         */
+        template<typename T, typename Compare>
+        T *partition(T *first, T *last, T *pivot, Compare &comp)
+        {
+            using std::swap;
+            while(true)
+            {
+                while(comp(*first, *pivot))
+                    ++first;
+                --last;
+                while(comp(*pivot, *last))
+                    --last;
+                if(!(first<last)) return first;
+                swap(*first, *last);
+                ++first;
+            }
+        }
+
+        /**
+         * quicksort that falls back to heap sort after depth bad splits,
+         * so the worst case stays O(n log n).
+         */
+        template<typename T, typename Compare>
+        void introSort(T *a, size_t n, size_t depth, Compare &comp)
+        {
+            while(n>INSERTION_LIMIT)
+            {
+                if(depth==0)
+                {
+                    heapSort(a, n, comp);
+                    return;
+                }
+                depth--;
+                medianToFront(a, a+1, a+n/2, a+n-1, comp);
+                T *cut=partition(a+1, a+n, a, comp);
+                size_t left=cut-a;
+                //recurse into the smaller side so the stack stays O(log n)
+                if(left<n-left)
+                {
+                    introSort(a, left, depth, comp);
+                    a=cut;
+                    n-=left;
+                } else
+                {
+                    introSort(cut, n-left, depth, comp);
+                    n=left;
+                }
+            }
+            insertionSort(a, n, comp);
+        }
+
+        template<typename T, typename Compare>
+        void introSort(T *a, size_t n, Compare comp)
+        {
+            size_t depth=0;
+            for(size_t m=n;m>1;m>>=1)
+                depth+=2;
+            introSort(a, n, depth, comp);
+        }
+
+        template<typename T, typename Compare>
+        void stableSort(T *a, T *tmp, size_t n, Compare &comp)
+        {
+            if(n<=32)
+            {
+                insertionSort(a, n, comp);
+                return;
+            }
+            size_t mid=n/2;
+            stableSort(a, tmp, mid, comp);
+            stableSort(a+mid, tmp+mid, n-mid, comp);
+            if(!comp(a[mid], a[mid-1])) return;
+            merge(a, tmp, mid, n, comp);
+        }
+
+        /**
+         * maps a key to an unsigned integer of the same width whose
+         * unsigned order is the order of the keys, for the radix passes.
+         */
+        template<typename K, bool=std::is_floating_point<K>::value, bool=std::is_signed<K>::value>
+        struct radix_key
+        {
+            typedef typename std::make_unsigned<K>::type type;
+
+            static type encode(K k)
+            {
+                return type(k);
+            }
+        };
+
+        template<typename K>
+        struct radix_key<K, false, true>
+        {
+            typedef typename std::make_unsigned<K>::type type;
+
+            static type encode(K k)
+            {
+                return type(type(k)^type(type(1)<<(sizeof(type)*8-1)));
+            }
+        };
+
+        /**
+         * negative numbers have every bit flipped, positive ones only the
+         * sign bit, so -0.0 sorts just before +0.0.
+         */
+        template<typename K>
+        struct radix_key<K, true, true>
+        {
+            typedef typename std::conditional<sizeof(K)==4, uint32_t, uint64_t>::type type;
+            static_assert(sizeof(K)==sizeof(type), "radix sort handles float and double keys only");
+
+            static type encode(K k)
+            {
+                type bits;
+                std::memcpy(&bits, &k, sizeof(bits));
+                const type sign=type(1)<<(sizeof(type)*8-1);
+                return bits&sign?type(~bits):type(bits|sign);
+            }
+        };
+
+        template<>
+        struct radix_key<bool, false, false>
+        {
+            typedef unsigned char type;
+
+            static type encode(bool k)
+            {
+                return k;
+            }
+        };
+
+        /**
+         * lsd radix sort on the bytes of key(element), least significant
+         * first, one histogram pass for all bytes and one scatter pass per
+         * byte that is not the same in every element. stable.
+         */
+        template<typename T, typename Key>
+        void radixPasses(T *a, size_t n, Key &key)
+        {
+            typedef typename std::decay<decltype(key(*a))>::type K;
+            typedef radix_key<K> traits;
+            typedef typename traits::type U;
+            const size_t DIGITS=sizeof(U);
+            size_t counts[DIGITS][256];
+            std::memset(counts, 0, sizeof(counts));
+            for(size_t i=0;i<n;++i)
+            {
+                U k=traits::encode(key(a[i]));
+                for(size_t d=0;d<DIGITS;++d)
+                    counts[d][(k>>(8*d))&255]++;
+            }
+            U sample=traits::encode(key(a[0]));
+            vector<T> tmp;
+            tmp.append(a, n);
+            T *from=a, *to=tmp.data();
+            for(size_t d=0;d<DIGITS;++d)
+            {
+                size_t *offset=counts[d];
+                if(offset[(sample>>(8*d))&255]==n) continue;
+                for(size_t b=0, sum=0;b<256;++b)
+                {
+                    size_t c=offset[b];
+                    offset[b]=sum;
+                    sum+=c;
+                }
+                for(size_t i=0;i<n;++i)
+                    to[offset[(traits::encode(key(from[i]))>>(8*d))&255]++]=std::move(from[i]);
+                std::swap(from, to);
+            }
+            if(from!=a)
+            {
+                for(size_t i=0;i<n;++i)
+                    a[i]=std::move(from[i]);
+            }
+        }
+
+        struct identity
+        {
+            template<typename T>
+            const T &operator()(const T &value) const
+            {
+                return value;
+            }
+        };
+
+        /**
+         * compares two elements by key(element).
+         */
+        template<typename Key>
+        struct key_less
+        {
+            Key key;
+
+            template<typename T>
+            bool operator()(const T &x, const T &y) const
+            {
+                return key(x)<key(y);
+            }
+        };
+
+        template<typename T, typename Compare>
+        void stableSort(T *a, size_t n, Compare comp)
+        {
+            if(n<=32)
+            {
+                insertionSort(a, n, comp);
+                return;
+            }
+            vector<T> tmp;
+            tmp.append(a, n);
+            stableSort(a, tmp.data(), n, comp);
+        }
+
+        template<typename T, typename Key>
+        void radixSort(T *a, size_t n, Key key)
+        {
+            if(n<RADIX_LIMIT)
+            {
+                key_less<Key> comp={key};
+                stableSort(a, n, comp);
+            } else radixPasses(a, n, key);
+        }
+
+        /**
+         * the elements radix_key can encode: integers, float and double.
+         */
+        template<typename T>
+        struct radix_sortable : std::integral_constant<bool, std::is_integral<T>::value
+                                                             ||std::is_same<T, float>::value||std::is_same<T, double>::value>
+        {};
+
+        /**
+         * the default order: radix sort for integer, float and double
+         * elements, where equal elements cannot be told apart and stability
+         * is free; comparison sorts for everything else.
+         */
+        template<typename T>
+        void sortDefault(T *a, size_t n, std::true_type, bool)
+        {
+            radixSort(a, n, identity());
+        }
+
+        template<typename T>
+        void sortDefault(T *a, size_t n, std::false_type, bool stable)
+        {
+            if(stable) stableSort(a, n, std::less<T>());
+            else introSort(a, n, std::less<T>());
+        }
+    }
+
+/**
+ * sort: introsort of [first, last), which must be contiguous (sjtu::vector
+ * iterators or pointers), in place. not stable.
+ * without a comparator, integer, float and double elements are radix
+ * sorted instead.
+ */
+    template<typename It, typename Compare>
+    void sort(It first, It last, Compare comp)
+    {
+        size_t n=last-first;
+        if(n>1) detail::introSort(&*first, n, comp);
+    }
+
+    template<typename It>
+    void sort(It first, It last)
+    {
+        typedef typename detail::value_of<It>::type T;
+        size_t n=last-first;
+        if(n>1) detail::sortDefault(&*first, n, detail::radix_sortable<T>(), false);
+    }
+
+/**
+ * stable_sort: merge sort of [first, last) through a scratch copy of the range.
+ */
+    template<typename It, typename Compare>
+    void stable_sort(It first, It last, Compare comp)
+    {
+        size_t n=last-first;
+        if(n>1) detail::stableSort(&*first, n, comp);
+    }
+
+    template<typename It>
+    void stable_sort(It first, It last)
+    {
+        typedef typename detail::value_of<It>::type T;
+        size_t n=last-first;
+        if(n>1) detail::sortDefault(&*first, n, detail::radix_sortable<T>(), true);
+    }
+
+/**
+ * radix_sort: stable sort of [first, last) by key(element), which must be
+ * an integral or floating point value (float or double). short ranges are
+ * merge sorted by key instead. without key the elements are the keys.
+ */
+    template<typename It, typename Key>
+    void radix_sort(It first, It last, Key key)
+    {
+        size_t n=last-first;
+        if(n>1) detail::radixSort(&*first, n, key);
+    }
+
+    template<typename It>
+    void radix_sort(It first, It last)
+    {
+        radix_sort(first, last, detail::identity());
+    }
+}
+
+#endif
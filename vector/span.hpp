@@ -0,0 +1,162 @@
+#ifndef SJTU_SPAN_HPP
+#define SJTU_SPAN_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu
+{
+/**
+ * a non-owning view of n contiguous elements: a pointer and a length.
+ * copying a span copies the view, never the elements, so sub-ranges of a
+ * vector can be passed around and sliced with first, last and subspan at
+ * no cost. const_span<T> is the read-only view.
+ *
+ * a span is made from a pointer range or from any container with data()
+ * and size() (vector, small_vector, mmap_vector, another span). it is
+ * invalidated by whatever invalidates that container's iterators.
+ * iterators are plain pointers.
+ */
+    template<typename T>
+    class span
+    {
+    public:
+        typedef T element_type;
+        typedef typename std::remove_cv<T>::type value_type;
+        typedef T *iterator;
+
+    private:
+        T *ptr;
+        size_t len;
+
+    public:
+        span() : ptr(nullptr), len(0)
+        {}
+
+        span(T *data, size_t n) : ptr(data), len(n)
+        {}
+
+        span(T *first, T *last) : ptr(first), len(last-first)
+        {}
+
+        /**
+         * views all of c; a span<const T> also takes a const container
+         * or a span<T>.
+         */
+        template<typename Container, typename=typename std::enable_if<
+                std::is_convertible<decltype(std::declval<Container &>().data()), T *>::value>::type>
+        span(Container &c) : ptr(c.data()), len(c.size())
+        {}
+
+        template<typename U, typename=typename std::enable_if<std::is_convertible<U *, T *>::value>::type>
+        span(const span<U> &other) : ptr(other.data()), len(other.size())
+        {}
+
+        /**
+         * access specified element with bounds checking
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        T &at(const size_t &pos) const
+        {
+            if(pos>=len) throw index_out_of_bound();
+            return ptr[pos];
+        }
+
+        /**
+         * checked like sjtu::vector; building with SJTU_UNCHECKED drops the check.
+         */
+        T &operator[](const size_t &pos) const
+        {
+#ifndef SJTU_UNCHECKED
+            if(pos>=len) throw index_out_of_bound();
+#endif
+            return ptr[pos];
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        T &front() const
+        {
+            if(len==0) throw container_is_empty();
+            return ptr[0];
+        }
+
+        T &back() const
+        {
+            if(len==0) throw container_is_empty();
+            return ptr[len-1];
+        }
+
+        T *data() const
+        {
+            return ptr;
+        }
+
+        iterator begin() const
+        {
+            return ptr;
+        }
+
+        iterator end() const
+        {
+            return ptr+len;
+        }
+
+        bool empty() const
+        {
+            return len==0;
+        }
+
+        size_t size() const
+        {
+            return len;
+        }
+
+        size_t size_bytes() const
+        {
+            return len*sizeof(T);
+        }
+
+        /**
+         * the first n elements.
+         * throw index_out_of_bound if n > size
+         */
+        span first(size_t n) const
+        {
+            if(n>len) throw index_out_of_bound();
+            return span(ptr, n);
+        }
+
+        /**
+         * the last n elements.
+         * throw index_out_of_bound if n > size
+         */
+        span last(size_t n) const
+        {
+            if(n>len) throw index_out_of_bound();
+            return span(ptr+len-n, n);
+        }
+
+        /**
+         * count elements from offset, or all of them from offset on when
+         * count is left out.
+         * throw index_out_of_bound if the range does not fit in the span
+         */
+        span subspan(size_t offset, size_t count=size_t(-1)) const
+        {
+            if(offset>len) throw index_out_of_bound();
+            if(count==size_t(-1)) count=len-offset;
+            else if(count>len-offset) throw index_out_of_bound();
+            return span(ptr+offset, count);
+        }
+    };
+
+    template<typename T>
+    using const_span=span<const T>;
+}
+
+#endif
@@ -0,0 +1,550 @@
+#ifndef SJTU_STABLE_VECTOR_HPP
+#define SJTU_STABLE_VECTOR_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace sjtu
+{
+/**
+ * a data container with the interface of sjtu::vector whose elements never
+ * change address. storage is a directory of segments of doubling size
+ * (8, 16, 32, ...); growing allocates one more segment and moves nothing,
+ * so pointers and references survive push_back and memory never needs
+ * the old and the new buffer at once. operator[] stays O(1): the segment
+ * of an index is the position of its highest bit.
+ *
+ * insert and erase in the middle shift values between the fixed slots,
+ * like sjtu::vector, so only end insertions keep element identity.
+ */
+    template<typename T>
+    class stable_vector
+    {
+    private:
+        static const size_t FIRST_SHIFT=3;
+        static const size_t FIRST=size_t(1)<<FIRST_SHIFT;
+        static const size_t MAX_SEGMENTS=sizeof(size_t)*8-FIRST_SHIFT;
+
+        T *segments[MAX_SEGMENTS];
+        size_t segmentCount;
+        size_t _size;
+
+        static size_t highBit(size_t x)
+        {
+            return sizeof(unsigned long long)*8-1-__builtin_clzll(x);
+        }
+
+        static size_t segmentSize(size_t k)
+        {
+            return FIRST<<k;
+        }
+
+        /**
+         * elements held by the first k segments.
+         */
+        static size_t capacityOf(size_t k)
+        {
+            return FIRST*((size_t(1)<<k)-1);
+        }
+
+        T *slot(size_t i) const
+        {
+            size_t j=i+FIRST, h=highBit(j);
+            return segments[h-FIRST_SHIFT]+(j-(size_t(1)<<h));
+        }
+
+        void addSegment()
+        {
+            segments[segmentCount]=static_cast<T *>(::operator new(segmentSize(segmentCount)*sizeof(T)));
+            segmentCount++;
+        }
+
+        void destroyAll()
+        {
+            for(size_t i=0;i<_size;++i)
+                slot(i)->~T();
+            _size=0;
+        }
+
+        void releaseFrom(size_t k)
+        {
+            while(segmentCount>k)
+            {
+                segmentCount--;
+                ::operator delete(segments[segmentCount]);
+            }
+        }
+
+        template<typename... Args>
+        T *emplaceEnd(Args &&...args)
+        {
+            if(_size==capacityOf(segmentCount)) addSegment();
+            T *p=slot(_size);
+            new(p) T(std::forward<Args>(args)...);
+            _size++;
+            return p;
+        }
+
+        template<typename... Args>
+        void emplaceAt(size_t pos, Args &&...args)
+        {
+            if(pos==_size)
+            {
+                emplaceEnd(std::forward<Args>(args)...);
+                return;
+            }
+            T value(std::forward<Args>(args)...);
+            emplaceEnd(std::move(*slot(_size-1)));
+            for(size_t i=_size-2;i>pos;--i)
+                *slot(i)=std::move(*slot(i-1));
+            *slot(pos)=std::move(value);
+        }
+
+        void eraseAt(size_t pos)
+        {
+            for(size_t i=pos+1;i<_size;++i)
+                *slot(i-1)=std::move(*slot(i));
+            _size--;
+            slot(_size)->~T();
+        }
+
+        void copyFrom(const stable_vector &other)
+        {
+            for(size_t i=0;i<other._size;++i)
+                emplaceEnd(*other.slot(i));
+        }
+
+        void stealFrom(stable_vector &other)
+        {
+            for(size_t k=0;k<other.segmentCount;++k)
+                segments[k]=other.segments[k];
+            segmentCount=other.segmentCount;
+            _size=other._size;
+            other.segmentCount=0;
+            other._size=0;
+        }
+
+    public:
+        class const_iterator;
+
+        class iterator
+        {
+            friend class stable_vector;
+
+        private:
+            stable_vector *vec;
+            size_t ptr;
+
+        public:
+            iterator operator+(const int &n) const
+            {
+                iterator it=*this;
+                it.ptr+=n;
+                return it;
+            }
+
+            iterator operator-(const int &n) const
+            {
+                iterator it=*this;
+                it.ptr-=n;
+                return it;
+            }
+
+            // return the distance between two iterators,
+            // if these two iterators point to different vectors, throw invaild_iterator.
+            int operator-(const iterator &rhs) const
+            {
+                if(vec!=rhs.vec) throw invalid_iterator();
+                return ptr-rhs.ptr;
+            }
+
+            iterator &operator+=(const int &n)
+            {
+                ptr+=n;
+                return *this;
+            }
+
+            iterator &operator-=(const int &n)
+            {
+                ptr-=n;
+                return *this;
+            }
+
+            iterator operator++(int)
+            {
+                iterator it=*this;
+                ptr++;
+                return it;
+            }
+
+            iterator &operator++()
+            {
+                ptr++;
+                return *this;
+            }
+
+            iterator operator--(int)
+            {
+                iterator it=*this;
+                ptr--;
+                return it;
+            }
+
+            iterator &operator--()
+            {
+                ptr--;
+                return *this;
+            }
+
+            T &operator*() const
+            {
+                return *vec->slot(ptr);
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+        };
+
+        class const_iterator
+        {
+            friend class stable_vector;
+
+        private:
+            const stable_vector *vec;
+            size_t ptr;
+
+        public:
+            const_iterator operator+(const int &n) const
+            {
+                const_iterator it=*this;
+                it.ptr+=n;
+                return it;
+            }
+
+            const_iterator operator-(const int &n) const
+            {
+                const_iterator it=*this;
+                it.ptr-=n;
+                return it;
+            }
+
+            int operator-(const const_iterator &rhs) const
+            {
+                if(vec!=rhs.vec) throw invalid_iterator();
+                return ptr-rhs.ptr;
+            }
+
+            const_iterator &operator+=(const int &n)
+            {
+                ptr+=n;
+                return *this;
+            }
+
+            const_iterator &operator-=(const int &n)
+            {
+                ptr-=n;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator it=*this;
+                ptr++;
+                return it;
+            }
+
+            const_iterator &operator++()
+            {
+                ptr++;
+                return *this;
+            }
+
+            const_iterator operator--(int)
+            {
+                const_iterator it=*this;
+                ptr--;
+                return it;
+            }
+
+            const_iterator &operator--()
+            {
+                ptr--;
+                return *this;
+            }
+
+            const T &operator*() const
+            {
+                return *vec->slot(ptr);
+            }
+
+            bool operator==(const iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator==(const const_iterator &rhs) const
+            {
+                return vec==rhs.vec&&ptr==rhs.ptr;
+            }
+
+            bool operator!=(const iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+
+            bool operator!=(const const_iterator &rhs) const
+            {
+                return !(*this==rhs);
+            }
+        };
+
+        /**
+         * no segment is allocated until the first element arrives.
+         */
+        stable_vector() : segmentCount(0), _size(0)
+        {}
+
+        stable_vector(const stable_vector &other) : segmentCount(0), _size(0)
+        {
+            copyFrom(other);
+        }
+
+        stable_vector(stable_vector &&other) noexcept
+        {
+            stealFrom(other);
+        }
+
+        ~stable_vector()
+        {
+            destroyAll();
+            releaseFrom(0);
+        }
+
+        stable_vector &operator=(const stable_vector &other)
+        {
+            if(this==&other) return *this;
+            destroyAll();
+            copyFrom(other);
+            return *this;
+        }
+
+        stable_vector &operator=(stable_vector &&other) noexcept
+        {
+            if(this==&other) return *this;
+            destroyAll();
+            releaseFrom(0);
+            stealFrom(other);
+            return *this;
+        }
+
+        /**
+         * access specified element with bounds checking
+         * throw index_out_of_bound if pos is not in [0, size)
+         */
+        T &at(const size_t &pos)
+        {
+            if(pos>=_size) throw index_out_of_bound();
+            return *slot(pos);
+        }
+
+        const T &at(const size_t &pos) const
+        {
+            if(pos>=_size) throw index_out_of_bound();
+            return *slot(pos);
+        }
+
+        T &operator[](const size_t &pos)
+        {
+            return at(pos);
+        }
+
+        const T &operator[](const size_t &pos) const
+        {
+            return at(pos);
+        }
+
+        /**
+         * throw container_is_empty if size == 0
+         */
+        const T &front() const
+        {
+            if(_size==0) throw container_is_empty();
+            return *slot(0);
+        }
+
+        const T &back() const
+        {
+            if(_size==0) throw container_is_empty();
+            return *slot(_size-1);
+        }
+
+        iterator begin()
+        {
+            iterator it;
+            it.vec=this;
+            it.ptr=0;
+            return it;
+        }
+
+        const_iterator cbegin() const
+        {
+            const_iterator it;
+            it.vec=this;
+            it.ptr=0;
+            return it;
+        }
+
+        iterator end()
+        {
+            iterator it;
+            it.vec=this;
+            it.ptr=_size;
+            return it;
+        }
+
+        const_iterator cend() const
+        {
+            const_iterator it;
+            it.vec=this;
+            it.ptr=_size;
+            return it;
+        }
+
+        bool empty() const
+        {
+            return _size==0;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        size_t capacity() const
+        {
+            return capacityOf(segmentCount);
+        }
+
+        /**
+         * clears the contents, keeping the segments for reuse.
+         */
+        void clear()
+        {
+            destroyAll();
+        }
+
+        void reserve(size_t n)
+        {
+            while(capacityOf(segmentCount)<n)
+                addSegment();
+        }
+
+        /**
+         * releases the segments past the last element.
+         */
+        void shrink_to_fit()
+        {
+            size_t k=0;
+            while(capacityOf(k)<_size)
+                k++;
+            releaseFrom(k);
+        }
+
+        /**
+         * inserts value before pos
+         * returns an iterator pointing to the inserted value.
+         */
+        iterator insert(iterator pos, const T &value)
+        {
+            emplaceAt(pos.ptr, value);
+            return pos;
+        }
+
+        iterator insert(iterator pos, T &&value)
+        {
+            emplaceAt(pos.ptr, std::move(value));
+            return pos;
+        }
+
+        /**
+         * throw index_out_of_bound if ind > size
+         */
+        iterator insert(const size_t &ind, const T &value)
+        {
+            if(ind>_size) throw index_out_of_bound();
+            emplaceAt(ind, value);
+            return begin()+ind;
+        }
+
+        /**
+         * removes the element at pos.
+         * return an iterator pointing to the following element.
+         */
+        iterator erase(iterator pos)
+        {
+            eraseAt(pos.ptr);
+            return pos;
+        }
+
+        /**
+         * throw index_out_of_bound if ind >= size
+         */
+        iterator erase(const size_t &ind)
+        {
+            if(ind>=_size) throw index_out_of_bound();
+            eraseAt(ind);
+            return begin()+ind;
+        }
+
+        /**
+         * adds an element to the end; no existing element moves.
+         */
+        void push_back(const T &value)
+        {
+            emplaceEnd(value);
+        }
+
+        void push_back(T &&value)
+        {
+            emplaceEnd(std::move(value));
+        }
+
+        template<typename... Args>
+        T &emplace_back(Args &&...args)
+        {
+            return *emplaceEnd(std::forward<Args>(args)...);
+        }
+
+        /**
+         * throw container_is_empty if size() == 0
+         */
+        void pop_back()
+        {
+            if(_size==0) throw container_is_empty();
+            _size--;
+            slot(_size)->~T();
+        }
+    };
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define SJTU_VECTOR_HPP
 
 #include "exceptions.hpp"
+#include "allocator.hpp"
 
 //#include "class-bint.hpp"
 //#include "class-integer.hpp"
@@ -9,34 +10,684 @@
 
 #include <climits>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace sjtu
 {
+/**
+ * growth policies of sjtu::vector.
+ * next(capacity) returns the capacity to grow to from a full, non-empty buffer.
+ */
+    struct double_growth
+    {
+        static size_t next(size_t capacity)
+        {
+            return capacity*2;
+        }
+    };
+
+    struct half_growth
+    {
+        static size_t next(size_t capacity)
+        {
+            return capacity+capacity/2+1;
+        }
+    };
+
+    /**
+     * grows by a fixed number of elements, for huge vectors where
+     * a geometric step would waste too much memory.
+     */
+    template<size_t Step>
+    struct fixed_growth
+    {
+        static size_t next(size_t capacity)
+        {
+            return capacity+Step;
+        }
+    };
+
+/**
+ * whether an object of T can be moved to a new address by copying its bytes
+ * and forgetting the original, without running any constructor or destructor.
+ * trivially copyable types are; specialize it to true_type for types that
+ * only own heap memory, e.g.
+ *   template<> struct sjtu::is_trivially_relocatable<Util::Bint> : std::true_type {};
+ */
+    template<typename T>
+    struct is_trivially_relocatable
+            : std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+    {};
+
+/**
+ * tag for resize(n, default_init): new elements are default-initialized,
+ * which leaves trivial types such as int uninitialized.
+ */
+    struct default_init_t
+    {};
+
+    constexpr default_init_t default_init{};
+
+/**
+ * holds the allocator of a container as a base class, so an empty
+ * allocator (the usual case) takes no space in the container.
+ */
+#if __cplusplus>=201402L
+    template<typename Alloc, bool=std::is_empty<Alloc>::value&&!std::is_final<Alloc>::value>
+#else
+    template<typename Alloc, bool=std::is_empty<Alloc>::value>
+#endif
+    class allocator_holder : private Alloc
+    {
+    protected:
+        allocator_holder()
+        {}
+
+        explicit allocator_holder(const Alloc &a) : Alloc(a)
+        {}
+
+        explicit allocator_holder(Alloc &&a) : Alloc(std::move(a))
+        {}
+
+        Alloc &alloc()
+        {
+            return *this;
+        }
+
+        const Alloc &alloc() const
+        {
+            return *this;
+        }
+    };
+
+    template<typename Alloc>
+    class allocator_holder<Alloc, false>
+    {
+    private:
+        Alloc a;
+
+    protected:
+        allocator_holder()
+        {}
+
+        explicit allocator_holder(const Alloc &a) : a(a)
+        {}
+
+        explicit allocator_holder(Alloc &&a) : a(std::move(a))
+        {}
+
+        Alloc &alloc()
+        {
+            return a;
+        }
+
+        const Alloc &alloc() const
+        {
+            return a;
+        }
+    };
+
 /**
  * a data container like std::vector
  * store data in a successive memory and support random access.
+ * storage comes from Alloc, see allocator.hpp.
+ *
+ * size and capacity are stored as Size, so a vector of a narrower Size
+ * (see compact_vector) is smaller but holds at most the largest Size;
+ * growing past that throws runtime_error.
+ * nothing is allocated until the first element arrives.
  */
-    template<typename T>
-    class vector
+    template<typename T, typename Growth=double_growth, typename Alloc=allocator<T>, typename Size=size_t>
+    class vector : private allocator_holder<Alloc>
     {
+        static_assert(std::is_unsigned<Size>::value, "the size type of vector must be unsigned");
+
+    public:
+        typedef Alloc allocator_type;
+
     private:
-        T **data;
-        size_t _size;
-        size_t capacity;
+        typedef std::allocator_traits<Alloc> traits;
+        typedef allocator_holder<Alloc> holder;
+
+        using holder::alloc;
+
+        static const size_t SIZE_LIMIT=std::numeric_limits<Size>::max()<std::numeric_limits<size_t>::max()
+                                       ?size_t(std::numeric_limits<Size>::max()):std::numeric_limits<size_t>::max();
+
+        T *_data;
+        Size _size;
+        Size _capacity;
+
+        /**
+         * raw storage for n elements, nothing is constructed in it.
+         */
+        T *allocate(size_t n)
+        {
+            return traits::allocate(alloc(), n);
+        }
+
+        /**
+         * n must be the capacity p was allocated with.
+         */
+        void deallocate(T *p, size_t n)
+        {
+            if(p!=nullptr) traits::deallocate(alloc(), p, n);
+        }
+
+        void moveAllocator(Alloc &other, std::true_type)
+        {
+            alloc()=std::move(other);
+        }
+
+        void moveAllocator(Alloc &, std::false_type)
+        {}
+
+        static void destroy(T *first, T *last)
+        {
+            destroy(first, last, std::is_trivially_destructible<T>());
+        }
+
+        static void destroy(T *, T *, std::true_type)
+        {}
+
+        static void destroy(T *first, T *last, std::false_type)
+        {
+            for(;first!=last;++first)
+                first->~T();
+        }
+
+        typedef std::integral_constant<bool, std::is_trivially_copyable<T>::value> trivially_copyable;
+        typedef std::integral_constant<bool, is_trivially_relocatable<T>::value> trivially_relocatable;
+
+        /**
+         * memmove for elements, the regions may overlap.
+         */
+        static void moveBytes(T *dest, const T *src, size_t n)
+        {
+            if(n) std::memmove(static_cast<void *>(dest), static_cast<const void *>(src), n*sizeof(T));
+        }
+
+        /**
+         * copy [first, last) into the uninitialized storage starting at dest.
+         */
+        static void uninitialized_copy(const T *first, const T *last, T *dest)
+        {
+            uninitialized_copy(first, last, dest, trivially_copyable());
+        }
+
+        static void uninitialized_copy(const T *first, const T *last, T *dest, std::true_type)
+        {
+            moveBytes(dest, first, last-first);
+        }
+
+        static void uninitialized_copy(const T *first, const T *last, T *dest, std::false_type)
+        {
+            T *cur=dest;
+            try
+            {
+                for(;first!=last;++first,++cur)
+                    new(cur) T(*first);
+            } catch(...)
+            {
+                destroy(dest, cur);
+                throw;
+            }
+        }
+
+        /**
+         * move [first, last) into the uninitialized storage starting at dest,
+         * copying when T's move constructor may throw. the sources are left
+         * alive; if a constructor throws, the copies made so far are destroyed.
+         */
+        static void moveConstruct(T *first, T *last, T *dest)
+        {
+            T *cur=dest;
+            try
+            {
+                for(;first!=last;++first,++cur)
+                    new(cur) T(std::move_if_noexcept(*first));
+            } catch(...)
+            {
+                destroy(dest, cur);
+                throw;
+            }
+        }
+
+        /**
+         * move [first, last) into the uninitialized storage starting at dest
+         * and destroy the sources. the sources are destroyed only once every
+         * element has been built at dest, so a throw leaves them intact.
+         */
+        static void relocate(T *first, T *last, T *dest)
+        {
+            relocate(first, last, dest, trivially_relocatable());
+        }
+
+        static void relocate(T *first, T *last, T *dest, std::true_type)
+        {
+            moveBytes(dest, first, last-first);
+        }
+
+        static void relocate(T *first, T *last, T *dest, std::false_type)
+        {
+            moveConstruct(first, last, dest);
+            destroy(first, last);
+        }
+
+        /**
+         * relocate the elements into the new buffer temp, leaving the n slots
+         * from index pos uninitialized. if an element throws, temp is left
+         * empty and the vector is unchanged.
+         */
+        void relocateTo(T *temp, size_t pos, size_t n)
+        {
+            relocateTo(temp, pos, n, trivially_relocatable());
+        }
+
+        void relocateTo(T *temp, size_t pos, size_t n, std::true_type)
+        {
+            moveBytes(temp, _data, pos);
+            moveBytes(temp+pos+n, _data+pos, _size-pos);
+        }
+
+        void relocateTo(T *temp, size_t pos, size_t n, std::false_type)
+        {
+            moveConstruct(_data, _data+pos, temp);
+            try
+            {
+                moveConstruct(_data+pos, _data+_size, temp+pos+n);
+            } catch(...)
+            {
+                destroy(temp, temp+pos);
+                throw;
+            }
+            destroy(_data, _data+_size);
+        }
+
+        /**
+         * frees the old buffer and takes temp, which holds the elements now.
+         */
+        void replaceBuffer(T *temp, size_t newCapacity)
+        {
+            deallocate(_data, _capacity);
+            _data=temp;
+            _capacity=newCapacity;
+        }
+
+        /**
+         * construct n copies of value in the uninitialized storage at dest;
+         * if one throws, the copies made so far are destroyed.
+         */
+        static void constructCopies(T *dest, size_t n, const T &value)
+        {
+            size_t i=0;
+            try
+            {
+                for(;i<n;++i)
+                    new(dest+i) T(value);
+            } catch(...)
+            {
+                destroy(dest, dest+i);
+                throw;
+            }
+        }
+
+        /**
+         * the most elements a buffer may hold: what Size can count and what
+         * the allocator can hand out in one block.
+         */
+        size_t maxCapacity() const
+        {
+            size_t limit=traits::max_size(alloc());
+            return limit<SIZE_LIMIT?limit:SIZE_LIMIT;
+        }
+
+        /**
+         * the capacity to grow to so that at least required elements fit.
+         */
+        size_t nextCapacity(size_t required) const
+        {
+            size_t limit=maxCapacity();
+            if(required>limit) throw runtime_error();
+            size_t newCapacity=_capacity?Growth::next(_capacity):10;
+            if(newCapacity<=_capacity) newCapacity=size_t(_capacity)+1;
+            if(newCapacity<required) newCapacity=required;
+            return newCapacity<limit?newCapacity:limit;
+        }
+
+        /**
+         * move all elements into a new buffer of exactly newCapacity (>= size).
+         */
+        void reallocate(size_t newCapacity)
+        {
+            if(newCapacity>maxCapacity()) throw runtime_error();
+            T *temp=newCapacity?allocate(newCapacity):nullptr;
+            try
+            {
+                relocateTo(temp, _size, 0);
+            } catch(...)
+            {
+                deallocate(temp, newCapacity);
+                throw;
+            }
+            replaceBuffer(temp, newCapacity);
+        }
+
+        /**
+         * grow the buffer and construct the new element at index pos in the
+         * new one first, so that args may safely refer to an element of this vector.
+         */
+        template<typename... Args>
+        void reallocEmplace(size_t pos, Args &&...args)
+        {
+            size_t newCapacity=nextCapacity(size_t(_size)+1);
+            T *temp=allocate(newCapacity);
+            try
+            {
+                new(temp+pos) T(std::forward<Args>(args)...);
+            } catch(...)
+            {
+                deallocate(temp, newCapacity);
+                throw;
+            }
+            try
+            {
+                relocateTo(temp, pos, 1);
+            } catch(...)
+            {
+                temp[pos].~T();
+                deallocate(temp, newCapacity);
+                throw;
+            }
+            replaceBuffer(temp, newCapacity);
+            _size++;
+        }
+
+        /**
+         * construct an element at index pos, shifting [pos, size) one slot right.
+         */
+        template<typename... Args>
+        void emplaceAt(size_t pos, Args &&...args)
+        {
+            if(_size==_capacity)
+            {
+                reallocEmplace(pos, std::forward<Args>(args)...);
+                return;
+            }
+            if(pos==_size)
+            {
+                new(_data+_size) T(std::forward<Args>(args)...);
+                _size++;
+                return;
+            }
+            T value(std::forward<Args>(args)...);
+            shiftInsert(pos, value, trivially_relocatable());
+            _size++;
+        }
+
+        void shiftInsert(size_t pos, T &value, std::true_type)
+        {
+            moveBytes(_data+pos+1, _data+pos, _size-pos);
+            new(_data+pos) T(std::move(value));
+        }
+
+        void shiftInsert(size_t pos, T &value, std::false_type)
+        {
+            new(_data+_size) T(std::move(_data[_size-1]));
+            for(size_t i=_size-1;i>pos;--i)
+                _data[i]=std::move(_data[i-1]);
+            _data[pos]=std::move(value);
+        }
+
+        /**
+         * make room for n elements at index pos with at most one reallocation.
+         * [pos, pos+n) is left as uninitialized storage and size is unchanged.
+         */
+        void openGap(size_t pos, size_t n)
+        {
+            if(_size+n>_capacity)
+            {
+                size_t newCapacity=nextCapacity(_size+n);
+                T *temp=allocate(newCapacity);
+                try
+                {
+                    relocateTo(temp, pos, n);
+                } catch(...)
+                {
+                    deallocate(temp, newCapacity);
+                    throw;
+                }
+                replaceBuffer(temp, newCapacity);
+                return;
+            }
+            openGap(pos, n, trivially_relocatable());
+        }
+
+        void openGap(size_t pos, size_t n, std::true_type)
+        {
+            moveBytes(_data+pos+n, _data+pos, _size-pos);
+        }
+
+        void openGap(size_t pos, size_t n, std::false_type)
+        {
+            //elements moving past the old end land on raw storage
+            size_t i=_size;
+            try
+            {
+                for(;i>pos;--i)
+                {
+                    if(i-1+n>=_size) new(_data+i-1+n) T(std::move(_data[i-1]));
+                    else _data[i-1+n]=std::move(_data[i-1]);
+                }
+            } catch(...)
+            {
+                //[0, size) is still constructed; drop what landed past it
+                destroy(_data+(i+n>_size?i+n:_size), _data+_size+n);
+                throw;
+            }
+            destroy(_data+pos, _data+(pos+n<_size?pos+n:_size));
+        }
+
+        /**
+         * undo openGap(pos, n) when filling the gap fails: [pos, pos+n) must
+         * be uninitialized again, and the tail moves back left onto it.
+         * if moving an element back throws, the rest of the tail is dropped
+         * and size shrinks to pos plus what moved back.
+         */
+        void closeGap(size_t pos, size_t n)
+        {
+            closeGap(pos, n, trivially_relocatable());
+        }
+
+        void closeGap(size_t pos, size_t n, std::true_type)
+        {
+            moveBytes(_data+pos, _data+pos+n, _size-pos);
+        }
+
+        void closeGap(size_t pos, size_t n, std::false_type)
+        {
+            size_t i=pos;
+            try
+            {
+                for(;i<_size;++i)
+                {
+                    new(_data+i) T(std::move(_data[i+n]));
+                    _data[i+n].~T();
+                }
+            } catch(...)
+            {
+                destroy(_data+i+n, _data+_size+n);
+                _size=i;
+            }
+        }
+
+        /**
+         * remove [first, last), shifting the tail left once.
+         */
+        void eraseRange(size_t first, size_t last)
+        {
+            if(first==last) return;
+            eraseRange(first, last, trivially_relocatable());
+        }
+
+        void eraseRange(size_t first, size_t last, std::true_type)
+        {
+            destroy(_data+first, _data+last);
+            moveBytes(_data+first, _data+last, _size-last);
+            _size-=last-first;
+        }
+
+        void eraseRange(size_t first, size_t last, std::false_type)
+        {
+            for(size_t i=last;i<_size;++i)
+                _data[i-(last-first)]=std::move(_data[i]);
+            destroy(_data+_size-(last-first), _data+_size);
+            _size-=last-first;
+        }
+
+        /**
+         * remove the element at index pos, shifting [pos+1, size) one slot left.
+         */
+        void eraseAt(size_t pos)
+        {
+            eraseRange(pos, pos+1);
+        }
+
+        /**
+         * the first index whose element is greater than value; elements equal
+         * to value stay before it, so equal keys keep their insertion order.
+         */
+        template<typename Compare>
+        size_t upperBound(const T &value, Compare &cmp) const
+        {
+            size_t first=0, n=_size;
+            while(n>0)
+            {
+                size_t half=n/2;
+                if(cmp(value, _data[first+half])) n=half;
+                else
+                {
+                    first+=half+1;
+                    n-=half+1;
+                }
+            }
+            return first;
+        }
+
+        /**
+         * default-initializes [_size, n), which fits in the capacity.
+         */
+        void defaultConstruct(size_t n, std::true_type)
+        {
+            _size=n;
+        }
 
-        void doubleSpace()
+        void defaultConstruct(size_t n, std::false_type)
         {
-            capacity*=2;
-            T **temp;
-            temp=data;
-            data=new T*[capacity];
-            for(size_t i=0;i<_size;++i)
+            for(;_size<n;++_size)
+                new(_data+_size) T;
+        }
+
+        /**
+         * whether It only supports one pass over its range, i.e. its
+         * iterator_category is input_iterator_tag. pointers and iterators
+         * without a category (the sjtu ones) are taken as multi-pass.
+         */
+        template<typename It>
+        struct single_pass
+        {
+        private:
+            template<typename U>
+            static typename std::is_same<typename U::iterator_category, std::input_iterator_tag>::type test(int);
+
+            template<typename U>
+            static std::false_type test(...);
+
+        public:
+            static const bool value=decltype(test<It>(0))::value;
+        };
+
+        /**
+         * inserts [first, last) at index ind; returns the number inserted.
+         */
+        template<typename InputIt>
+        size_t insertRange(size_t ind, InputIt first, InputIt last, std::false_type)
+        {
+            size_t n=0;
+            for(InputIt it=first;it!=last;++it)
+                n++;
+            if(n==0) return 0;
+            openGap(ind, n);
+            try
+            {
+                constructRange(first, last, _data+ind);
+            } catch(...)
+            {
+                closeGap(ind, n);
+                throw;
+            }
+            _size+=n;
+            return n;
+        }
+
+        template<typename InputIt>
+        size_t insertRange(size_t ind, InputIt first, InputIt last, std::true_type)
+        {
+            vector temp(alloc());
+            for(;first!=last;++first)
+                temp.push_back(*first);
+            size_t n=temp._size;
+            if(n==0) return 0;
+            openGap(ind, n);
+            try
+            {
+                relocate(temp._data, temp._data+n, _data+ind);
+            } catch(...)
+            {
+                closeGap(ind, n);
+                throw;
+            }
+            temp._size=0;
+            _size+=n;
+            return n;
+        }
+
+        /**
+         * construct copies of [first, last) into the uninitialized storage at dest.
+         * contiguous sources of T are copied in bulk. if a copy throws, the
+         * copies made so far are destroyed.
+         */
+        template<typename InputIt>
+        static void constructRange(InputIt first, InputIt last, T *dest)
+        {
+            T *cur=dest;
+            try
             {
-                data[i]=new T(*temp[i]);
+                for(;first!=last;++first,++cur)
+                    new(cur) T(*first);
+            } catch(...)
+            {
+                destroy(dest, cur);
+                throw;
             }
-            for(size_t i=0;i<_size;++i)
-                delete temp[i];
-            delete [] temp;
+        }
+
+        static void constructRange(const T *first, const T *last, T *dest)
+        {
+            uninitialized_copy(first, last, dest);
+        }
+
+        static void constructRange(T *first, T *last, T *dest)
+        {
+            uninitialized_copy(first, last, dest);
         }
 
     public:
@@ -49,14 +700,22 @@ namespace sjtu
          * you can see RandomAccessIterator at CppReference for help.
          */
 
+#ifdef SJTU_UNCHECKED
+        /**
+         * unchecked build: iterators are plain pointers into the buffer,
+         * so hot loops pay no extra indirection.
+         */
+        typedef T *iterator;
+        typedef const T *const_iterator;
+#else
         class const_iterator;
 
         class iterator
         {
-            friend class vector<T>;
+            friend class vector;
 
         private:
-            vector<T> *vec;
+            vector *vec;
             size_t ptr;
 
         public:
@@ -141,7 +800,7 @@ namespace sjtu
              */
             T &operator*() const
             {
-                return *(vec->data[ptr]);
+                return vec->_data[ptr];
             }
 
             /**
@@ -185,17 +844,17 @@ namespace sjtu
          */
         class const_iterator
         {
-            friend class vector<T>;
+            friend class vector;
 
         private:
-            const vector<T> *vec;
+            const vector *vec;
             size_t ptr;
 
         public:
             const_iterator operator+(const int &n) const
             {
                 const_iterator it=*this;
-                it.it_ptr+=n;
+                it.ptr+=n;
                 return it;
             }
 
@@ -252,7 +911,7 @@ namespace sjtu
 
             T &operator*() const
             {
-                return *(vec->data[ptr]);
+                return vec->_data[ptr];
             }
 
             bool operator==(const iterator &rhs) const
@@ -282,27 +941,87 @@ namespace sjtu
                 return false;
             }
         };
+#endif
+
+    private:
+        size_t indexOf(const iterator &pos) const
+        {
+#ifdef SJTU_UNCHECKED
+            return pos-_data;
+#else
+            return pos.ptr;
+#endif
+        }
 
+        iterator iteratorAt(size_t i)
+        {
+#ifdef SJTU_UNCHECKED
+            return _data+i;
+#else
+            iterator it;
+            it.vec=this;
+            it.ptr=i;
+            return it;
+#endif
+        }
+
+        const_iterator constIteratorAt(size_t i) const
+        {
+#ifdef SJTU_UNCHECKED
+            return _data+i;
+#else
+            const_iterator it;
+            it.vec=this;
+            it.ptr=i;
+            return it;
+#endif
+        }
+
+    public:
         /**
          * TODO Constructs
          * Atleast two: default constructor, copy constructor
          */
         vector()
         {
+            _data=nullptr;
             _size=0;
-            capacity=10;
-            data=new T*[capacity];
+            _capacity=0;
         }
 
-        vector(const vector &other)
+        explicit vector(const Alloc &a) : holder(a)
         {
-            _size=other._size;
-            capacity=other.capacity;
-            data=new T*[capacity];
-            for(size_t i=0;i<_size;++i)
+            _data=nullptr;
+            _size=0;
+            _capacity=0;
+        }
+
+        vector(const vector &other) : holder(traits::select_on_container_copy_construction(other.alloc()))
+        {
+            _capacity=other._capacity;
+            _data=_capacity?allocate(_capacity):nullptr;
+            try
             {
-                data[i]=new T(*(other.data[i]));
+                uninitialized_copy(other._data, other._data+other._size, _data);
+            } catch(...)
+            {
+                deallocate(_data, _capacity);
+                throw;
             }
+            _size=other._size;
+        }
+
+        /**
+         * steals the buffer of other, which is left empty with no storage.
+         */
+        vector(vector &&other) noexcept : holder(std::move(other.alloc()))
+        {
+            _data=other._data;
+            _size=other._size;
+            _capacity=other._capacity;
+            other._data=nullptr;
+            other._size=0;
+            other._capacity=0;
         }
 
         /**
@@ -310,9 +1029,8 @@ namespace sjtu
          */
         ~vector()
         {
-            for(size_t i=0;i<_size;++i)
-                delete data[i];
-            delete [] data;
+            destroy(_data, _data+_size);
+            deallocate(_data, _capacity);
             _size=0;
         }
 
@@ -323,18 +1041,61 @@ namespace sjtu
         {
             if(this==&other) return *this;
 
-            //first forgotten
-            for(size_t i=0;i<_size;++i)
-                delete data[i];
-            delete [] data;
+            //copy into a new buffer first, so a throw leaves us untouched
+            if(other._size>_capacity)
+            {
+                T *temp=allocate(other._capacity);
+                try
+                {
+                    uninitialized_copy(other._data, other._data+other._size, temp);
+                } catch(...)
+                {
+                    deallocate(temp, other._capacity);
+                    throw;
+                }
+                destroy(_data, _data+_size);
+                replaceBuffer(temp, other._capacity);
+                _size=other._size;
+                return *this;
+            }
 
+            //keep our own buffer when the elements fit in it
+            destroy(_data, _data+_size);
+            _size=0;
+            uninitialized_copy(other._data, other._data+other._size, _data);
             _size=other._size;
-            capacity=other.capacity;
-            data=new T*[capacity];
-            for(size_t i=0;i<_size;++i)
+            return *this;
+        }
+
+        /**
+         * steals the buffer of other when the allocators allow it; otherwise
+         * the elements are moved one by one into storage from our allocator.
+         */
+        vector &operator=(vector &&other) noexcept(traits::propagate_on_container_move_assignment::value)
+        {
+            if(this==&other) return *this;
+
+            if(!traits::propagate_on_container_move_assignment::value&&alloc()!=other.alloc())
             {
-                data[i]=new T(*(other.data[i]));
+                destroy(_data, _data+_size);
+                _size=0;
+                if(other._size>_capacity) reallocate(other._size);
+                for(;_size<other._size;++_size)
+                    new(_data+_size) T(std::move(other._data[_size]));
+                other.clear();
+                return *this;
             }
+
+            destroy(_data, _data+_size);
+            deallocate(_data, _capacity);
+            moveAllocator(other.alloc(), typename traits::propagate_on_container_move_assignment());
+
+            _data=other._data;
+            _size=other._size;
+            _capacity=other._capacity;
+            other._data=nullptr;
+            other._size=0;
+            other._capacity=0;
             return *this;
         }
 
@@ -345,13 +1106,13 @@ namespace sjtu
         T &at(const size_t &pos)
         {
             if(pos<0||pos>=_size) throw index_out_of_bound();
-            return *data[pos];
+            return _data[pos];
         }
 
         const T &at(const size_t &pos) const
         {
             if(pos<0||pos>=_size) throw index_out_of_bound();
-            return *data[pos];
+            return _data[pos];
         }
 
         /**
@@ -359,17 +1120,22 @@ namespace sjtu
          * throw index_out_of_bound if pos is not in [0, size)
          * !!! Pay attentions
          *   In STL this operator does not check the boundary but I want you to do.
+         * building with SJTU_UNCHECKED drops the check, as in STL.
          */
         T &operator[](const size_t &pos)
         {
-            if(pos<0||pos>=_size) throw index_out_of_bound();
-            return *data[pos];
+#ifndef SJTU_UNCHECKED
+            if(pos>=_size) throw index_out_of_bound();
+#endif
+            return _data[pos];
         }
 
         const T &operator[](const size_t &pos) const
         {
-            if(pos<0||pos>=_size) throw index_out_of_bound();
-            return *data[pos];
+#ifndef SJTU_UNCHECKED
+            if(pos>=_size) throw index_out_of_bound();
+#endif
+            return _data[pos];
         }
 
         /**
@@ -379,7 +1145,7 @@ namespace sjtu
         const T &front() const
         {
             if(size()==0) throw container_is_empty();
-            return *data[0];
+            return _data[0];
         }
 
         /**
@@ -389,7 +1155,21 @@ namespace sjtu
         const T &back() const
         {
             if(size()==0) throw container_is_empty();
-            return *data[_size-1];
+            return _data[_size-1];
+        }
+
+        /**
+         * direct access to the underlying contiguous storage.
+         * [data(), data() + size()) is a valid range, even when empty.
+         */
+        T *data()
+        {
+            return _data;
+        }
+
+        const T *data() const
+        {
+            return _data;
         }
 
         /**
@@ -397,18 +1177,12 @@ namespace sjtu
          */
         iterator begin()
         {
-            iterator it;
-            it.vec=this;
-            it.ptr=0;
-            return it;
+            return iteratorAt(0);
         }
 
         const_iterator cbegin() const
         {
-            const_iterator it;
-            it.vec=this;
-            it.ptr=0;
-            return it;
+            return constIteratorAt(0);
         }
 
         /**
@@ -416,18 +1190,12 @@ namespace sjtu
          */
         iterator end()
         {
-            iterator it;
-            it.vec=this;
-            it.ptr=_size;
-            return it;
+            return iteratorAt(_size);
         }
 
         const_iterator cend() const
         {
-            const_iterator it;
-            it.vec=this;
-            it.ptr=_size;
-            return it;
+            return constIteratorAt(_size);
         }
 
         /**
@@ -435,7 +1203,7 @@ namespace sjtu
          */
         bool empty() const
         {
-            return begin()==end();
+            return _size==0;
         }
 
         /**
@@ -451,12 +1219,122 @@ namespace sjtu
          */
         void clear()
         {
-            for(int i=0;i<_size;++i)
-                delete data[i];
-            delete [] data;
+            destroy(_data, _data+_size);
             _size=0;
-            capacity=10;
-            data=new T*[capacity];
+        }
+
+        /**
+         * returns the number of elements that fit without reallocation.
+         */
+        size_t capacity() const
+        {
+            return _capacity;
+        }
+
+        Alloc get_allocator() const
+        {
+            return alloc();
+        }
+
+        /**
+         * grows the capacity to at least n, never shrinks it.
+         */
+        void reserve(size_t n)
+        {
+            if(n>_capacity) reallocate(n);
+        }
+
+        /**
+         * releases the unused capacity; an empty vector gives up its buffer.
+         */
+        void shrink_to_fit()
+        {
+            if(_size<_capacity) reallocate(_size);
+        }
+
+        /**
+         * changes the number of elements to n,
+         * appending value-initialized elements or destroying the tail.
+         */
+        void resize(size_t n)
+        {
+            if(n<=_size)
+            {
+                destroy(_data+n, _data+_size);
+                _size=n;
+                return;
+            }
+            if(n>_capacity) reallocate(nextCapacity(n));
+            for(;_size<n;++_size)
+                new(_data+_size) T();
+        }
+
+        /**
+         * same as resize(n), appending copies of value instead.
+         */
+        void resize(size_t n, const T &value)
+        {
+            if(n<=_size)
+            {
+                destroy(_data+n, _data+_size);
+                _size=n;
+                return;
+            }
+            if(n>_capacity)
+            {
+                size_t newCapacity=nextCapacity(n);
+                T *temp=allocate(newCapacity);
+                try
+                {
+                    constructCopies(temp+_size, n-_size, value);
+                } catch(...)
+                {
+                    deallocate(temp, newCapacity);
+                    throw;
+                }
+                try
+                {
+                    relocateTo(temp, _size, 0);
+                } catch(...)
+                {
+                    destroy(temp+_size, temp+n);
+                    deallocate(temp, newCapacity);
+                    throw;
+                }
+                replaceBuffer(temp, newCapacity);
+                _size=n;
+                return;
+            }
+            for(;_size<n;++_size)
+                new(_data+_size) T(value);
+        }
+
+        /**
+         * same as resize(n), appending default-initialized elements instead:
+         * a trivially default constructible T is left uninitialized, so the
+         * new tail can be filled directly (by fread, recv, ...) without being
+         * zeroed first.
+         */
+        void resize(size_t n, default_init_t)
+        {
+            if(n<=_size)
+            {
+                destroy(_data+n, _data+_size);
+                _size=n;
+                return;
+            }
+            if(n>_capacity) reallocate(nextCapacity(n));
+            defaultConstruct(n, std::is_trivially_default_constructible<T>());
+        }
+
+        /**
+         * resize(n, default_init) for types that need no construction at all.
+         * the elements in [size(), n) hold indeterminate values until written.
+         */
+        void resize_uninitialized(size_t n)
+        {
+            static_assert(std::is_trivially_default_constructible<T>::value, "resize_uninitialized needs a trivially default constructible T");
+            resize(n, default_init);
         }
 
         /**
@@ -465,12 +1343,9 @@ namespace sjtu
          */
         iterator insert(iterator pos, const T &value)
         {
-            if(_size==capacity) doubleSpace();
-            for(size_t i=_size;i>pos.ptr;--i)
-                data[i]=data[i-1];
-            data[pos.ptr]=new T(value);
-            _size++;
-            return pos;
+            size_t ind=indexOf(pos);
+            emplaceAt(ind, value);
+            return iteratorAt(ind);
         }
 
         /**
@@ -482,14 +1357,121 @@ namespace sjtu
         iterator insert(const size_t &ind, const T &value)
         {
             if(ind>_size) throw index_out_of_bound();
-            if(_size==capacity) doubleSpace();
-            for(size_t i=_size;i>ind;--i)
-                data[i]=data[i-1];
-            data[ind]=new T(value);
-            _size++;
-            iterator it;
-            it=begin()+ind;
-            return it;
+            emplaceAt(ind, value);
+            return iteratorAt(ind);
+        }
+
+        /**
+         * inserts value into a vector sorted by cmp, after the elements equal
+         * to it, keeping it sorted. the slot is found by binary search and the
+         * tail is moved once, as a block for trivially relocatable T.
+         * returns an iterator pointing to the inserted value.
+         */
+        template<typename Compare>
+        iterator insert_sorted(const T &value, Compare cmp)
+        {
+            size_t ind=upperBound(value, cmp);
+            emplaceAt(ind, value);
+            return iteratorAt(ind);
+        }
+
+        template<typename Compare>
+        iterator insert_sorted(T &&value, Compare cmp)
+        {
+            size_t ind=upperBound(value, cmp);
+            emplaceAt(ind, std::move(value));
+            return iteratorAt(ind);
+        }
+
+        iterator insert_sorted(const T &value)
+        {
+            return insert_sorted(value, std::less<T>());
+        }
+
+        iterator insert_sorted(T &&value)
+        {
+            return insert_sorted(std::move(value), std::less<T>());
+        }
+
+        /**
+         * inserts n copies of value before pos, shifting the tail only once.
+         * returns an iterator pointing to the first inserted element.
+         */
+        iterator insert(iterator pos, size_t n, const T &value)
+        {
+            if(n==0) return pos;
+            size_t ind=indexOf(pos);
+            T copy(value);
+            openGap(ind, n);
+            try
+            {
+                constructCopies(_data+ind, n, copy);
+            } catch(...)
+            {
+                closeGap(ind, n);
+                throw;
+            }
+            _size+=n;
+            return iteratorAt(ind);
+        }
+
+        /**
+         * inserts a copy of [first, last) before pos, shifting the tail only once.
+         * first and last must not point into this vector. single-pass input
+         * iterators (std::istream_iterator, ...) are read into a temporary
+         * vector first, since the range cannot be counted and then copied.
+         * returns an iterator pointing to the first inserted element.
+         */
+        template<typename InputIt, typename std::enable_if<!std::is_integral<InputIt>::value, int>::type=0>
+        iterator insert(iterator pos, InputIt first, InputIt last)
+        {
+            size_t ind=indexOf(pos);
+            if(!insertRange(ind, first, last, std::integral_constant<bool, single_pass<InputIt>::value>())) return pos;
+            return iteratorAt(ind);
+        }
+
+        iterator insert(iterator pos, T &&value)
+        {
+            size_t ind=indexOf(pos);
+            emplaceAt(ind, std::move(value));
+            return iteratorAt(ind);
+        }
+
+        iterator insert(const size_t &ind, T &&value)
+        {
+            if(ind>_size) throw index_out_of_bound();
+            emplaceAt(ind, std::move(value));
+            return iteratorAt(ind);
+        }
+
+#ifdef SJTU_UNCHECKED
+        /**
+         * iterators are pointers here, so a literal 0 converts to iterator as
+         * well as to size_t; any integral index takes the index overloads.
+         */
+        template<typename Index, typename std::enable_if<std::is_integral<Index>::value, int>::type=0>
+        iterator insert(Index ind, const T &value)
+        {
+            return insert(size_t(ind), value);
+        }
+
+        template<typename Index, typename std::enable_if<std::is_integral<Index>::value, int>::type=0>
+        iterator insert(Index ind, T &&value)
+        {
+            return insert(size_t(ind), std::move(value));
+        }
+#endif
+
+        /**
+         * constructs an element in place before pos from args.
+         * returns an iterator pointing to the new element.
+         */
+        template<typename... Args>
+        iterator emplace(iterator pos, Args &&...args)
+        {
+            size_t ind=indexOf(pos);
+            emplaceAt(ind, std::forward<Args>(args)...);
+            return iteratorAt(ind);
         }
 
         /**
@@ -499,13 +1481,42 @@ namespace sjtu
          */
         iterator erase(iterator pos)
         {
-            delete data[pos.ptr];
-            _size--;
-            for(size_t i=pos.ptr;i<_size;++i)
-                data[i]=data[i+1];
+            eraseAt(indexOf(pos));
             return pos;
         }
 
+        /**
+         * removes the elements in [first, last).
+         * returns an iterator pointing to the element that followed them.
+         */
+        iterator erase(iterator first, iterator last)
+        {
+            eraseRange(indexOf(first), indexOf(last));
+            return first;
+        }
+
+        /**
+         * removes every element for which pred returns true in one pass:
+         * the survivors are moved forward in order and the tail is destroyed.
+         * returns the number of elements removed.
+         */
+        template<typename Predicate>
+        size_t erase_if(Predicate pred)
+        {
+            T *end=_data+_size, *out=_data;
+            while(out!=end&&!pred(*out))
+                ++out;
+            if(out==end) return 0;
+            for(T *p=out+1;p!=end;++p)
+            {
+                if(!pred(*p)) *out++=std::move(*p);
+            }
+            size_t removed=end-out;
+            destroy(out, end);
+            _size-=removed;
+            return removed;
+        }
+
         /**
          * removes the element with index ind.
          * return an iterator pointing to the following element.
@@ -513,24 +1524,79 @@ namespace sjtu
          */
         iterator erase(const size_t &ind)
         {
-            if(ind>_size) throw index_out_of_bound();
-            delete data[ind];
-            _size--;
-            for(size_t i=ind;i<_size;++i)
-                data[i]=data[i+1];
-            iterator it;
-            it=begin()+ind;
-            return it;
+            if(ind>=_size) throw index_out_of_bound();
+            eraseAt(ind);
+            return iteratorAt(ind);
+        }
+
+#ifdef SJTU_UNCHECKED
+        template<typename Index, typename std::enable_if<std::is_integral<Index>::value, int>::type=0>
+        iterator erase(Index ind)
+        {
+            return erase(size_t(ind));
         }
+#endif
 
         /**
          * adds an element to the end.
          */
         void push_back(const T &value)
         {
-            if(_size==capacity) doubleSpace();
-            data[_size]=new T(value);
-            _size++;
+            emplace_back(value);
+        }
+
+        void push_back(T &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        /**
+         * adds copies of the n elements starting at ptr to the end,
+         * reallocating at most once. ptr may point into this vector.
+         */
+        void append(const T *ptr, size_t n)
+        {
+            if(n==0) return;
+            if(_size+n>_capacity)
+            {
+                size_t newCapacity=nextCapacity(_size+n);
+                T *temp=allocate(newCapacity);
+                try
+                {
+                    uninitialized_copy(ptr, ptr+n, temp+_size);
+                } catch(...)
+                {
+                    deallocate(temp, newCapacity);
+                    throw;
+                }
+                try
+                {
+                    relocateTo(temp, _size, 0);
+                } catch(...)
+                {
+                    destroy(temp+_size, temp+_size+n);
+                    deallocate(temp, newCapacity);
+                    throw;
+                }
+                replaceBuffer(temp, newCapacity);
+            } else uninitialized_copy(ptr, ptr+n, _data+_size);
+            _size+=n;
+        }
+
+        /**
+         * constructs an element in place at the end from args.
+         * returns a reference to the new element.
+         */
+        template<typename... Args>
+        T &emplace_back(Args &&...args)
+        {
+            if(_size==_capacity) reallocEmplace(_size, std::forward<Args>(args)...);
+            else
+            {
+                new(_data+_size) T(std::forward<Args>(args)...);
+                _size++;
+            }
+            return _data[_size-1];
         }
 
         /**
@@ -540,12 +1606,18 @@ namespace sjtu
         void pop_back()
         {
             if(size()==0) throw container_is_empty();
-            delete data[_size-1];
             _size--;
+            _data[_size].~T();
         }
     };
 
-
+/**
+ * a vector with 32-bit size and capacity: 16 bytes instead of 24 with the
+ * default allocator, for the many mostly-empty vectors kept inside other
+ * structures. holds at most 2^32-1 elements.
+ */
+    template<typename T, typename Size=uint32_t, typename Alloc=allocator<T>>
+    using compact_vector=vector<T, double_growth, Alloc, Size>;
 }
 
 #endif